@@ -0,0 +1,424 @@
+//
+//  Battle TowerZ - Copyright(c) 2025 NoZ Games, LLC
+//
+
+// Screen height in pixels below which an animator drops to the next tier
+constexpr float ANIMATION_LOD_HALF_PIXELS = 64.0f;
+constexpr float ANIMATION_LOD_QUARTER_PIXELS = 24.0f;
+constexpr float ANIMATION_LOD_DEFAULT_HEIGHT = 1.0f;
+
+constexpr int MAX_BAKED_ANIMATIONS = 32;
+constexpr float BAKED_ANIMATION_FRAME_RATE = 60.0f;
+
+constexpr int WORLD_BONES_BATCH_SIZE = 64;
+
+// Units smaller than this on screen are drawn as impostors, the exit threshold is larger so units
+// near the boundary do not flicker between the two
+constexpr float IMPOSTOR_ENTER_PIXELS = 16.0f;
+constexpr float IMPOSTOR_EXIT_PIXELS = 20.0f;
+constexpr int IMPOSTOR_FRAME_COUNT = 8;
+constexpr float IMPOSTOR_LINE_WIDTH = 0.06f;
+constexpr float IMPOSTOR_HEAD_SIZE = 0.1f;
+
+// Clip resampled at a fixed rate into frame_count * bone_count packed bone matrices.  Only the
+// bones in the mask are stored, bone_indices maps a packed bone back to the skeleton.
+struct BakedAnimation {
+    Animation* animation;
+    const Name* name;
+    Mat3* frames;
+    int frame_count;
+    int bone_count;
+    u8 bone_indices[BONE_STICK_COUNT];
+    u32 bone_mask;
+    bool enabled;
+    Mesh* impostors[IMPOSTOR_FRAME_COUNT];
+};
+
+struct AnimationSystem {
+    Bounds2 view_bounds;
+    float pixels_per_unit;
+    BakedAnimation baked[MAX_BAKED_ANIMATIONS];
+    int baked_count;
+
+    // Sized to the entity pool, live units and ragdolls together are not bound by MAX_UNITS and
+    // every visible unit needs a slot
+    UnitEntity* world_units[MAX_ENTITIES];
+    int world_unit_count;
+    Mat3 world_bones[MAX_ENTITIES][BONE_STICK_COUNT];
+    Mat3 shadow_bones[MAX_ENTITIES][BONE_STICK_COUNT];
+};
+
+static AnimationSystem g_animation = {};
+
+// Advances the animator clock by the accumulated delay without evaluating it.  Returns false
+// when the animator has to be evaluated itself.  Assumes clips play at speed 1, as every Play
+// call does.
+static bool GetSampleTime(Entity* entity, float* time) {
+    Animator& animator = entity->animator;
+    if (!animator.animation)
+        return false;
+
+    float duration = GetDuration(animator.animation);
+    if (duration <= F32_EPSILON)
+        return false;
+
+    *time = animator.time + entity->animation_delay;
+    if (IsLooping(animator))
+        *time = fmodf(*time, duration);
+    else if (*time >= duration)
+        return false;   // let the animator finish the clip
+
+    return true;
+}
+
+static BakedAnimation* GetBakedAnimation(Animation* animation) {
+    for (int i = 0; i < g_animation.baked_count; i++)
+        if (g_animation.baked[i].animation == animation)
+            return &g_animation.baked[i];
+
+    return nullptr;
+}
+
+static void UnpackBakedFrame(const BakedAnimation& baked, int frame, Mat3* bones) {
+    const Mat3* packed = baked.frames + frame * baked.bone_count;
+    for (int i = 0; i < baked.bone_count; i++)
+        bones[baked.bone_indices[i]] = packed[i];
+}
+
+// Baked clips are a table lookup, the masked bones of the nearest frame are copied into the
+// animator.  Bones outside the mask are never drawn and keep whatever they held.
+static bool UpdateBakedPose(Entity* entity) {
+    BakedAnimation* baked = GetBakedAnimation(entity->animator.animation);
+    if (!baked || !baked->enabled)
+        return false;
+
+    float time;
+    if (!GetSampleTime(entity, &time))
+        return false;
+
+    int frame = Min(static_cast<int>(time * BAKED_ANIMATION_FRAME_RATE + 0.5f), baked->frame_count - 1);
+    entity->animator.time = time;
+    UnpackBakedFrame(*baked, frame, entity->animator.bones);
+    entity->bones = entity->animator.bones;
+    g_game.stats.baked_samples++;
+    return true;
+}
+
+// Far away units are drawn as the impostor of the nearest animation phase.  Only the draw is
+// replaced, the bones are still posed so ragdolls, attachments and arrows start from them.
+static Mesh* GetImpostor(Entity* entity) {
+    BakedAnimation* baked = GetBakedAnimation(entity->animator.animation);
+    if (!baked || !baked->impostors[0])
+        return nullptr;
+
+    float phase = Clamp(entity->animator.time / GetDuration(baked->animation), 0.0f, 1.0f);
+    int frame = Min(static_cast<int>(phase * IMPOSTOR_FRAME_COUNT), IMPOSTOR_FRAME_COUNT - 1);
+    g_game.stats.impostors++;
+    return baked->impostors[frame];
+}
+
+void BeginAnimationFrame() {
+    g_animation.view_bounds = GetBounds(g_game.camera);
+    float view_height = g_animation.view_bounds.max.y - g_animation.view_bounds.min.y;
+    g_animation.pixels_per_unit = view_height > F32_EPSILON ? GetScreenSize().y / view_height : 0.0f;
+}
+
+static AnimationLod GetAnimationLod(Entity* e, float height) {
+    const Bounds2& bounds = g_animation.view_bounds;
+    Vec2 position = WorldToScreen(e->position);
+    if (position.x + height < bounds.min.x ||
+        position.x - height > bounds.max.x ||
+        position.y + height < bounds.min.y ||
+        position.y - height > bounds.max.y)
+        return ANIMATION_LOD_FROZEN;
+
+    float pixels = height * g_animation.pixels_per_unit;
+    if (pixels >= ANIMATION_LOD_HALF_PIXELS)
+        return ANIMATION_LOD_FULL;
+    if (pixels >= ANIMATION_LOD_QUARTER_PIXELS)
+        return ANIMATION_LOD_HALF;
+    return ANIMATION_LOD_QUARTER;
+}
+
+// Advances the entity animator at a rate chosen by how large the entity is on screen.  Skipped
+// frames are accumulated and applied on the next evaluation so the pose never loses phase.
+void UpdateAnimator(Entity* entity, float height) {
+    if (height <= 0.0f)
+        height = ANIMATION_LOD_DEFAULT_HEIGHT;
+
+    AnimationLod lod = GetAnimationLod(entity, height);
+
+    // Clips that end a unit state have to keep running off screen
+    if (lod == ANIMATION_LOD_FROZEN && !IsLooping(entity->animator))
+        lod = ANIMATION_LOD_QUARTER;
+
+    float pixels = height * g_animation.pixels_per_unit;
+    if (entity->impostor_lod)
+        entity->impostor_lod = pixels < IMPOSTOR_EXIT_PIXELS;
+    else
+        entity->impostor_lod = pixels < IMPOSTOR_ENTER_PIXELS;
+
+    entity->animation_lod = lod;
+    entity->animation_delay += GetGameFrameTime();
+    g_game.stats.animators[lod]++;
+
+    if (lod == ANIMATION_LOD_FROZEN)
+        return;
+
+    // Stagger reduced rate animators across frames so the cost is spread evenly
+    u32 interval_mask = (1u << lod) - 1;
+    if (((g_game.frame_index + GetIndex(g_game.entity_allocator, entity)) & interval_mask) != 0)
+        return;
+
+    if (!UpdateBakedPose(entity)) {
+        float frame_time = GetFrameTime();
+        if (frame_time > F32_EPSILON)
+            Update(entity->animator, entity->animation_delay / frame_time);
+        entity->bones = entity->animator.bones;
+    }
+
+    entity->impostor = entity->impostor_lod ? GetImpostor(entity) : nullptr;
+
+    entity->animation_delay = 0.0f;
+    g_game.stats.animators_evaluated[lod]++;
+}
+
+static bool IsBakedImpostor(const Entity* entity) {
+    if (!entity->impostor)
+        return false;
+
+    for (int i = 0; i < g_animation.baked_count; i++)
+        for (Mesh* impostor : g_animation.baked[i].impostors)
+            if (entity->impostor == impostor)
+                return true;
+
+    return false;
+}
+
+static bool ReleaseBakedImpostor(u32, void* item, void*) {
+    Entity* entity = static_cast<Entity*>(item);
+    if (IsBakedImpostor(entity))
+        entity->impostor = nullptr;
+    return true;
+}
+
+// Entities drawing a baked impostor drop it before the meshes are freed, their bones are always
+// posed in the animator and stay valid
+void ClearBakedAnimations() {
+    if (g_game.entity_allocator)
+        Enumerate(g_game.entity_allocator, ReleaseBakedImpostor);
+
+    for (int i = 0; i < g_animation.baked_count; i++) {
+        Free(g_animation.baked[i].frames);
+        for (Mesh* impostor : g_animation.baked[i].impostors)
+            if (impostor)
+                Free(impostor);
+    }
+
+    g_animation.baked_count = 0;
+}
+
+static void AddBakedAnimation(Animation* animation, const Name* name, u32 bone_mask, bool enabled) {
+    if (!animation || GetDuration(animation) <= F32_EPSILON)
+        return;
+
+    // Clips shared by several unit types keep every bone any of them draws and are sampled live
+    // when any of them asks for it
+    if (BakedAnimation* baked = GetBakedAnimation(animation)) {
+        baked->bone_mask |= bone_mask;
+        baked->enabled &= enabled;
+        return;
+    }
+
+    if (g_animation.baked_count >= MAX_BAKED_ANIMATIONS)
+        return;
+
+    BakedAnimation& baked = g_animation.baked[g_animation.baked_count++];
+    baked = {};
+    baked.animation = animation;
+    baked.name = name;
+    baked.bone_mask = bone_mask ? bone_mask : BONE_MASK_ALL;
+    baked.enabled = enabled;
+}
+
+// Only bones in the clip mask are stored.  The engine evaluates a skeleton as a whole so every
+// sample still runs the full clip, but that only happens at load.
+static void SampleBakedAnimation(BakedAnimation& baked) {
+    float duration = GetDuration(baked.animation);
+
+    // Every unit type is drawn on the stick skeleton
+    Animator animator = {};
+    Init(animator, SKELETON_STICK);
+    Play(animator, baked.animation, 1.0f, false);
+
+    baked.frame_count = static_cast<int>(ceilf(duration * BAKED_ANIMATION_FRAME_RATE)) + 1;
+    baked.bone_count = 0;
+    for (int bone_index = 0; bone_index < BONE_STICK_COUNT; bone_index++)
+        if (baked.bone_mask & BoneMask(bone_index))
+            baked.bone_indices[baked.bone_count++] = static_cast<u8>(bone_index);
+
+    size_t size = sizeof(Mat3) * baked.frame_count * baked.bone_count;
+    baked.frames = static_cast<Mat3*>(Alloc(ALLOCATOR_DEFAULT, size));
+
+    for (int frame = 0; frame < baked.frame_count; frame++) {
+        animator.time = Min(frame / BAKED_ANIMATION_FRAME_RATE, duration);
+        Update(animator, 0.0f);
+
+        Mat3* bones = baked.frames + frame * baked.bone_count;
+        for (int i = 0; i < baked.bone_count; i++)
+            bones[i] = animator.bones[baked.bone_indices[i]];
+    }
+}
+
+static void AddImpostorQuad(MeshBuilder* builder, int* vertex_count, const Vec2& a, const Vec2& b, float width, const Vec2& uv) {
+    Vec2 direction = b - a;
+    float length = Length(direction);
+    Vec2 normal = length > F32_EPSILON ? Vec2{-direction.y, direction.x} * (width * 0.5f / length) : Vec2{0.0f, width * 0.5f};
+
+    u16 base = static_cast<u16>(*vertex_count);
+    AddVertex(builder, a + normal, uv);
+    AddVertex(builder, b + normal, uv);
+    AddVertex(builder, b - normal, uv);
+    AddVertex(builder, a - normal, uv);
+    AddTriangle(builder, base + 0, base + 1, base + 2);
+    AddTriangle(builder, base + 0, base + 2, base + 3);
+    *vertex_count += 4;
+}
+
+// Impostors are flat stick figures built from evenly spaced baked frames: one quad from every
+// drawn bone to its drawn parent and a square for the head.  The root only anchors the figure.
+static void BuildImpostors(BakedAnimation& baked) {
+    Skeleton* skeleton = SKELETON_STICK;
+    Vec2 uv = ColorUV(6,1);
+    int max_quads = baked.bone_count + 1;
+
+    PushScratch();
+    MeshBuilder* builder = CreateMeshBuilder(ALLOCATOR_SCRATCH, max_quads * 4, max_quads * 6);
+    for (int impostor = 0; impostor < IMPOSTOR_FRAME_COUNT; impostor++) {
+        int frame = impostor * (baked.frame_count - 1) / IMPOSTOR_FRAME_COUNT;
+        Mat3 bones[BONE_STICK_COUNT] = {};
+        UnpackBakedFrame(baked, frame, bones);
+
+        Clear(builder);
+        int vertex_count = 0;
+        for (int bone_index = 1; bone_index < BONE_STICK_COUNT; bone_index++) {
+            int parent_index = GetBone(skeleton, bone_index).parent_index;
+            if (parent_index <= 0 || !(baked.bone_mask & BoneMask(bone_index)) || !(baked.bone_mask & BoneMask(parent_index)))
+                continue;
+
+            AddImpostorQuad(builder, &vertex_count, TransformPoint(bones[parent_index]), TransformPoint(bones[bone_index]), IMPOSTOR_LINE_WIDTH, uv);
+        }
+
+        Vec2 head = TransformPoint(bones[BONE_STICK_HEAD]);
+        AddImpostorQuad(builder, &vertex_count, head - Vec2{0.0f, IMPOSTOR_HEAD_SIZE}, head + Vec2{0.0f, IMPOSTOR_HEAD_SIZE}, IMPOSTOR_HEAD_SIZE * 2.0f, uv);
+
+        baked.impostors[impostor] = CreateMesh(ALLOCATOR_DEFAULT, builder, NAME_NONE, true);
+    }
+    PopScratch();
+}
+
+static bool IsLiveAnimation(const UnitInfo* info, Animation* animation) {
+    for (Animation* live_animation : info->live_animations)
+        if (live_animation && live_animation == animation)
+            return true;
+
+    return false;
+}
+
+// Resamples every clip referenced by the unit database.  Runs after the database is built and
+// again whenever assets are reloaded.  Clips listed in UnitInfo::live_animations are still
+// resampled for their impostors but animators evaluate them from the keyframes.
+void BakeUnitAnimations() {
+    ClearBakedAnimations();
+
+    for (int unit_type = 0; unit_type < UNIT_TYPE_COUNT; unit_type++) {
+        const UnitInfo* info = GetUnitInfo(static_cast<UnitType>(unit_type));
+        Animation* animations[] = {
+            info->idle_animation,
+            info->move_animation,
+            info->shuffle_animation,
+            info->attack_animation,
+            info->reload_animation
+        };
+
+        for (Animation* animation : animations)
+            AddBakedAnimation(animation, info->name, info->bone_mask, !IsLiveAnimation(info, animation));
+    }
+
+    for (int i = 0; i < g_animation.baked_count; i++) {
+        SampleBakedAnimation(g_animation.baked[i]);
+        BuildImpostors(g_animation.baked[i]);
+    }
+}
+
+void ReportBakedAnimations() {
+    size_t total = 0;
+    for (int i = 0; i < g_animation.baked_count; i++) {
+        const BakedAnimation& baked = g_animation.baked[i];
+        size_t size = sizeof(Mat3) * baked.frame_count * baked.bone_count;
+        total += size;
+        LogInfo("baked animation %d (first used by %s): %d frames, %d/%d bones, %zu bytes, %s",
+            i,
+            baked.name ? baked.name->value : "",
+            baked.frame_count,
+            baked.bone_count,
+            BONE_STICK_COUNT,
+            size,
+            baked.enabled ? "baked" : "live");
+    }
+
+    LogInfo("baked animations: %d clips, %zu bytes", g_animation.baked_count, total);
+}
+
+static void AddWorldBonesUnit(Entity* e) {
+    if (e->type != ENTITY_TYPE_UNIT)
+        return;
+
+    // Impostors are drawn from the entity transform alone but their bones are kept current too
+    UnitEntity* u = static_cast<UnitEntity*>(e);
+    if (!u->info || !u->info->bone_mask)
+        return;
+
+    assert(g_animation.world_unit_count < MAX_ENTITIES);
+    int slot = g_animation.world_unit_count++;
+    g_animation.world_units[slot] = u;
+    u->world_bones = g_animation.world_bones[slot];
+    u->shadow_bones = g_animation.shadow_bones[slot];
+}
+
+static void ComputeWorldBones(int start, int end, void* user_data) {
+    Vec2 shadow_scale = *static_cast<Vec2*>(user_data);
+    for (int slot = start; slot < end; slot++) {
+        UnitEntity* u = g_animation.world_units[slot];
+        Vec2 position = WorldToScreen(u->position);
+        Mat3 transform = TRS(position, u->rotation, u->scale);
+        Mat3 shadow_transform = TRS(position, u->rotation, u->scale * shadow_scale);
+        Mat3* world_bones = g_animation.world_bones[slot];
+        Mat3* shadow_bones = g_animation.shadow_bones[slot];
+        u32 bone_mask = u->info->bone_mask;
+        for (int bone_index = 0; bone_index < BONE_STICK_COUNT; bone_index++) {
+            if (!(bone_mask & BoneMask(bone_index)))
+                continue;
+
+            world_bones[bone_index] = transform * u->bones[bone_index];
+            shadow_bones[bone_index] = shadow_transform * u->bones[bone_index];
+        }
+    }
+}
+
+// Every drawn bone of every visible unit is moved to world space once per frame, for both the
+// main and the shadow pass, after the animators and ragdolls have been updated and the entities
+// have been culled.  Draw code reads the results through Entity::world_bones and
+// Entity::shadow_bones, which are only valid for entities in the visible lists.
+void UpdateWorldBones(const Vec2& shadow_scale) {
+    g_animation.world_unit_count = 0;
+
+    int visible_count;
+    Entity** visible = GetVisibleEntities(CULL_PASS_ANY, &visible_count);
+    for (int i = 0; i < visible_count; i++)
+        AddWorldBonesUnit(visible[i]);
+
+    Vec2 scale = shadow_scale;
+    RunParallel(ComputeWorldBones, g_animation.world_unit_count, WORLD_BONES_BATCH_SIZE, &scale);
+    g_game.stats.world_bone_units = g_animation.world_unit_count;
+}
@@ -0,0 +1,195 @@
+//
+//  Battle TowerZ - Copyright(c) 2025 NoZ Games, LLC
+//
+
+constexpr int MAX_AUDIO_REQUESTS = 1024;
+constexpr int MAX_AUDIO_SOUNDS = 32;
+constexpr int MAX_SOUND_VOICES = 4;
+
+// Nothing reports when a voice ends, so a voice holds its slot for a fixed time
+constexpr float AUDIO_VOICE_TIME = 0.5f;
+constexpr float AUDIO_PITCH_VARIANCE = 0.05f;
+constexpr float AUDIO_MAX_VOLUME = 1.0f;
+constexpr float AUDIO_NEAR_DISTANCE = 5.0f;
+constexpr float AUDIO_FAR_DISTANCE = 40.0f;
+
+struct AudioRequest {
+    Sound* sound;
+    Vec2 position;
+    float volume;
+    float pitch;
+};
+
+struct AudioVoice {
+    SoundHandle handle;
+    float start_time;
+    float volume;
+};
+
+struct AudioSoundVoices {
+    Sound* sound;
+    AudioVoice voices[MAX_SOUND_VOICES];
+    int voice_count;
+};
+
+// Sounds are requested here during the frame and mixed down once per frame.  All requests of the
+// same sound become a single voice whose volume grows with the number of requests, and every sound
+// is held to a few voices at a time.  Voices go out through play_func and stolen voices are cut
+// through stop_func, so the whole layer can be driven without an audio device.
+struct AudioSystem {
+    AudioRequest requests[MAX_AUDIO_REQUESTS];
+    int request_count;
+    AudioSoundVoices sounds[MAX_AUDIO_SOUNDS];
+    int sound_count;
+    AudioPlayFunc play_func;
+    AudioStopFunc stop_func;
+    float time;
+};
+
+static AudioSystem g_audio = {};
+
+static SoundHandle PlayEngineSound(Sound* sound, float volume, float pitch) {
+    return Play(sound, volume, pitch);
+}
+
+static void StopEngineSound(const SoundHandle& handle) {
+    Stop(handle);
+}
+
+void PlaySoundAt(Sound* sound, const Vec2& position, float volume, float pitch) {
+    if (!sound)
+        return;
+
+    g_game.stats.sound_requests++;
+    if (g_audio.request_count >= MAX_AUDIO_REQUESTS) {
+        g_game.stats.sound_dropped++;
+        return;
+    }
+
+    g_audio.requests[g_audio.request_count++] = { sound, position, volume, pitch };
+}
+
+float GetSoundAttenuation(const Vec2& listener, const Vec2& position) {
+    float distance = Length(position - listener);
+    if (distance <= AUDIO_NEAR_DISTANCE)
+        return 1.0f;
+
+    return Clamp(1.0f - (distance - AUDIO_NEAR_DISTANCE) / (AUDIO_FAR_DISTANCE - AUDIO_NEAR_DISTANCE), 0.0f, 1.0f);
+}
+
+// Uncorrelated copies of the same sound add up in power, not amplitude
+float GetCoalescedVolume(float volume, int count) {
+    return Min(volume * sqrtf(static_cast<float>(count)), AUDIO_MAX_VOLUME);
+}
+
+static AudioSoundVoices* GetSoundVoices(Sound* sound) {
+    for (int i = 0; i < g_audio.sound_count; i++)
+        if (g_audio.sounds[i].sound == sound)
+            return &g_audio.sounds[i];
+
+    if (g_audio.sound_count >= MAX_AUDIO_SOUNDS)
+        return nullptr;
+
+    AudioSoundVoices* voices = &g_audio.sounds[g_audio.sound_count++];
+    *voices = {};
+    voices->sound = sound;
+    return voices;
+}
+
+// Takes a free voice, or steals the quietest (oldest first on a tie) when the new one is louder.
+// A stolen voice is stopped so the sound never plays more voices than it holds.
+static AudioVoice* AllocVoice(AudioSoundVoices& voices, float volume) {
+    if (voices.voice_count < MAX_SOUND_VOICES)
+        return &voices.voices[voices.voice_count++];
+
+    AudioVoice* quietest = &voices.voices[0];
+    for (int i = 1; i < voices.voice_count; i++) {
+        AudioVoice& voice = voices.voices[i];
+        if (voice.volume < quietest->volume || (voice.volume == quietest->volume && voice.start_time < quietest->start_time))
+            quietest = &voice;
+    }
+
+    if (quietest->volume >= volume)
+        return nullptr;
+
+    g_audio.stop_func(quietest->handle);
+    g_game.stats.sound_stolen++;
+    return quietest;
+}
+
+static void RetireVoices() {
+    for (int sound_index = 0; sound_index < g_audio.sound_count; sound_index++) {
+        AudioSoundVoices& voices = g_audio.sounds[sound_index];
+        for (int i = voices.voice_count - 1; i >= 0; i--)
+            if (g_audio.time - voices.voices[i].start_time >= AUDIO_VOICE_TIME)
+                voices.voices[i] = voices.voices[--voices.voice_count];
+    }
+}
+
+void UpdateAudio(const Vec2& listener, float frame_time) {
+    g_audio.time += frame_time;
+    RetireVoices();
+
+    // Requests are grouped by sound in place, the first request of each group collects the others
+    for (int i = 0; i < g_audio.request_count; i++) {
+        AudioRequest& request = g_audio.requests[i];
+        if (!request.sound)
+            continue;
+
+        int count = 0;
+        float loudest = 0.0f;
+        float pitch = request.pitch;
+        for (int j = i; j < g_audio.request_count; j++) {
+            AudioRequest& other = g_audio.requests[j];
+            if (other.sound != request.sound)
+                continue;
+
+            float volume = other.volume * GetSoundAttenuation(listener, other.position);
+            if (volume > loudest) {
+                loudest = volume;
+                pitch = other.pitch;
+            }
+
+            if (j != i)
+                other.sound = nullptr;
+            count++;
+        }
+
+        g_game.stats.sound_coalesced += count - 1;
+
+        if (loudest <= 0.0f) {
+            g_game.stats.sound_dropped++;
+            continue;
+        }
+
+        AudioSoundVoices* voices = GetSoundVoices(request.sound);
+        float volume = GetCoalescedVolume(loudest, count);
+        AudioVoice* voice = voices ? AllocVoice(*voices, volume) : nullptr;
+        if (!voice) {
+            g_game.stats.sound_dropped++;
+            continue;
+        }
+
+        pitch *= RandomFloat(1.0f - AUDIO_PITCH_VARIANCE, 1.0f + AUDIO_PITCH_VARIANCE);
+        *voice = { g_audio.play_func(request.sound, volume, pitch), g_audio.time, volume };
+        g_game.stats.sound_voices++;
+    }
+
+    g_audio.request_count = 0;
+}
+
+void SetAudioPlayFunc(AudioPlayFunc play_func, AudioStopFunc stop_func) {
+    g_audio.play_func = play_func ? play_func : PlayEngineSound;
+    g_audio.stop_func = stop_func ? stop_func : StopEngineSound;
+}
+
+void InitAudio() {
+    g_audio = {};
+    g_audio.play_func = PlayEngineSound;
+    g_audio.stop_func = StopEngineSound;
+}
+
+void ClearAudio() {
+    g_audio.request_count = 0;
+    g_audio.sound_count = 0;
+}
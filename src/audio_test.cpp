@@ -0,0 +1,83 @@
+//
+//  Battle TowerZ - Copyright(c) 2025 NoZ Games, LLC
+//
+
+#include "test.h"
+
+constexpr float AUDIO_TEST_FRAME_TIME = 0.01f;
+
+struct AudioTestLog {
+    int play_count;
+    int stop_count;
+    u64 last_stopped;
+    float last_volume;
+};
+
+static AudioTestLog g_audio_test = {};
+static int g_audio_test_sounds[2] = {};
+
+static Sound* GetTestSound(int index) {
+    return reinterpret_cast<Sound*>(&g_audio_test_sounds[index]);
+}
+
+// Handles count up from 1 in play order
+static SoundHandle RecordPlay(Sound*, float volume, float) {
+    g_audio_test.last_volume = volume;
+    return SoundHandle{ static_cast<u64>(++g_audio_test.play_count) };
+}
+
+static void RecordStop(const SoundHandle& handle) {
+    g_audio_test.stop_count++;
+    g_audio_test.last_stopped = handle.value;
+}
+
+static void BeginAudioTest() {
+    InitAudio();
+    SetAudioPlayFunc(RecordPlay, RecordStop);
+    g_audio_test = {};
+}
+
+TEST(AudioCoalescesRequestsOfOneSound) {
+    BeginAudioTest();
+
+    PlaySoundAt(GetTestSound(0), VEC2_ZERO, 0.25f);
+    PlaySoundAt(GetTestSound(0), VEC2_ZERO, 0.25f);
+    PlaySoundAt(GetTestSound(0), VEC2_ZERO, 0.25f);
+    PlaySoundAt(GetTestSound(0), VEC2_ZERO, 0.25f);
+    UpdateAudio(VEC2_ZERO, AUDIO_TEST_FRAME_TIME);
+
+    EXPECT(g_audio_test.play_count == 1);
+    EXPECT_NEAR(g_audio_test.last_volume, 0.5f, 0.0001f);
+}
+
+TEST(AudioStopsStolenVoice) {
+    BeginAudioTest();
+
+    // Fill every voice of the sound, one per frame and each louder than the last
+    for (int i = 0; i < 4; i++) {
+        PlaySoundAt(GetTestSound(0), VEC2_ZERO, 0.1f * static_cast<float>(i + 1));
+        UpdateAudio(VEC2_ZERO, AUDIO_TEST_FRAME_TIME);
+    }
+
+    EXPECT(g_audio_test.play_count == 4);
+    EXPECT(g_audio_test.stop_count == 0);
+
+    // Quieter than every voice, nothing is stolen
+    PlaySoundAt(GetTestSound(0), VEC2_ZERO, 0.05f);
+    UpdateAudio(VEC2_ZERO, AUDIO_TEST_FRAME_TIME);
+    EXPECT(g_audio_test.play_count == 4);
+    EXPECT(g_audio_test.stop_count == 0);
+
+    // Louder than the quietest voice, which is stopped before its slot is reused
+    PlaySoundAt(GetTestSound(0), VEC2_ZERO, 0.9f);
+    UpdateAudio(VEC2_ZERO, AUDIO_TEST_FRAME_TIME);
+    EXPECT(g_audio_test.play_count == 5);
+    EXPECT(g_audio_test.stop_count == 1);
+    EXPECT(g_audio_test.last_stopped == 1);
+
+    // Other sounds have voices of their own
+    PlaySoundAt(GetTestSound(1), VEC2_ZERO, 0.1f);
+    UpdateAudio(VEC2_ZERO, AUDIO_TEST_FRAME_TIME);
+    EXPECT(g_audio_test.play_count == 6);
+    EXPECT(g_audio_test.stop_count == 1);
+}
@@ -173,12 +173,33 @@ void UpdateBattle() {
         TestRagdollOnRandomUnit();
     }
 
+    if (WasButtonPressed(g_battle.input, KEY_G))
+        g_game.show_overlay = !g_game.show_overlay;
+
+    if (WasButtonPressed(g_battle.input, KEY_H))
+        g_game.show_influence = !g_game.show_influence;
+
+    if (WasButtonPressed(g_battle.input, KEY_J))
+        g_game.show_stats = !g_game.show_stats;
+
     if (g_battle.state == BATTLE_STATE_SIMULATE)
         CheckForWinner();
 
     UpdateCameraZoom();
     UpdateCameraPan();
+}
+
+// Runs on the simulation thread, everything the renderer needs leaves through the snapshot
+void SimulateBattle() {
+    if (!IsGameState(GAME_STATE_BATTLE))
+        return;
+
+    UpdateRagdolls(GetGameFrameTime());
+    UpdateFlowFields(GetGameFrameTime());
+    UpdateInfluenceMaps();
+    BeginAnimationFrame();
     Enumerate(g_game.entity_allocator, UpdateEntity);
+    UpdateSeparation();
 }
 
 void DrawBattle() {
@@ -186,6 +207,8 @@ void DrawBattle() {
         return;
 
     DrawGrid(g_game.camera);
+    DrawGround();
+    DrawInfluenceMaps();
 }
 
 void HandleUnitDeath(UnitEntity* entity, DamageType damage_type) {
@@ -195,6 +218,11 @@ void HandleUnitDeath(UnitEntity* entity, DamageType damage_type) {
 
 void ShutdownBattle() {
     PopInputSet();
+    ClearGround();
+    ClearVfx();
+    ClearAudio();
+    ClearFlowFields();
+    ClearStaticObstacles();
     Free(g_battle.input);
     g_battle = {};
 }
@@ -213,11 +241,16 @@ void InitBattle() {
     EnableButton(g_battle.input, KEY_ESCAPE);
     EnableButton(g_battle.input, KEY_TAB);
     EnableButton(g_battle.input, KEY_SPACE);
+    EnableButton(g_battle.input, KEY_G);
+    EnableButton(g_battle.input, KEY_H);
+    EnableButton(g_battle.input, KEY_J);
     PushInputSet(g_battle.input);
 
     SetGameTimeScale(1.0f);
 
     DestroyAllEntities();
+    ClearGround();
+    ClearStaticObstacles();
 
     for (int i = 0; i < g_game.battle_setup.unit_count; ++i) {
         const UnitSetup& unit_setup = g_game.battle_setup.units[i];
@@ -227,5 +260,8 @@ void InitBattle() {
             unit_setup.position);
     }
 
+    // Static units registered themselves as obstacles while being created
+    BuildObstacleField();
+
     ResetCamera();
 }
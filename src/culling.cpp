@@ -0,0 +1,214 @@
+//
+//  Battle TowerZ - Copyright(c) 2025 NoZ Games, LLC
+//
+
+constexpr float CULL_CELL_SIZE = 4.0f;
+constexpr int CULL_BUCKET_COUNT = 4096;
+constexpr float CULL_DEFAULT_EXTENT = 1.0f;
+
+// Ragdolls are thrown away from the unit position, so the bounds of dead units get extra room
+constexpr float CULL_DEAD_EXTENT = 2.0f;
+
+// Screen space bounds of an entity for the main and shadow pass, relative to its screen position.
+// Entries are indexed by the render slot of the entity and chained into the bucket they are in.
+struct CullEntry {
+    Entity* entity;
+    Vec2 position;
+    Bounds2 bounds;
+    Bounds2 shadow_bounds;
+    int bucket;
+    int prev;
+    int next;
+    u32 seen;
+    u32 visited;
+};
+
+// Entities are hashed into a grid of screen space cells by position.  The grid persists between
+// frames and an entity is only moved to another bucket when it crosses into a cell that hashes
+// differently.  A query only visits the cells under the view, widened by the largest entity
+// extent, and then tests the bounds of the entities found there.
+struct CullSystem {
+    CullEntry entries[MAX_ENTITIES];
+    int slots[MAX_ENTITIES];
+    int slot_count;
+    int bucket_head[CULL_BUCKET_COUNT];
+    bool initialized;
+    float max_extent;
+    u32 frame;
+    u32 query;
+    Entity* visible[CULL_PASS_COUNT][MAX_ENTITIES];
+    int visible_count[CULL_PASS_COUNT];
+};
+
+static CullSystem g_cull = {};
+
+static int GetCullCell(float value) {
+    return static_cast<int>(floorf(value / CULL_CELL_SIZE));
+}
+
+static int GetCullBucket(int cell_x, int cell_y) {
+    u32 hash = static_cast<u32>(cell_x) * 73856093u ^ static_cast<u32>(cell_y) * 19349663u;
+    return static_cast<int>(hash & (CULL_BUCKET_COUNT - 1));
+}
+
+static bool CullOverlaps(const Bounds2& a, const Bounds2& b) {
+    return a.min.x <= b.max.x && a.max.x >= b.min.x && a.min.y <= b.max.y && a.max.y >= b.min.y;
+}
+
+static void LinkCullEntry(int slot, int bucket) {
+    CullEntry& entry = g_cull.entries[slot];
+    entry.bucket = bucket;
+    entry.prev = -1;
+    entry.next = g_cull.bucket_head[bucket];
+    if (entry.next != -1)
+        g_cull.entries[entry.next].prev = slot;
+    g_cull.bucket_head[bucket] = slot;
+}
+
+static void UnlinkCullEntry(int slot) {
+    CullEntry& entry = g_cull.entries[slot];
+    if (entry.prev != -1)
+        g_cull.entries[entry.prev].next = entry.next;
+    else
+        g_cull.bucket_head[entry.bucket] = entry.next;
+
+    if (entry.next != -1)
+        g_cull.entries[entry.next].prev = entry.prev;
+
+    entry.bucket = -1;
+}
+
+static void InitCullGrid() {
+    for (int& head : g_cull.bucket_head)
+        head = -1;
+    for (CullEntry& entry : g_cull.entries)
+        entry.bucket = -1;
+
+    g_cull.slot_count = 0;
+    g_cull.initialized = true;
+}
+
+static void UpdateCullEntry(Entity* e, const Vec2& shadow_scale) {
+    float width = CULL_DEFAULT_EXTENT;
+    float height = CULL_DEFAULT_EXTENT;
+    if (e->type == ENTITY_TYPE_UNIT) {
+        UnitEntity* u = static_cast<UnitEntity*>(e);
+        if (u->info && u->info->height > 0.0f) {
+            width = Max(u->size, u->info->height * 0.5f);
+            height = u->info->height;
+        }
+
+        if (u->state == UNIT_STATE_DEAD) {
+            width += CULL_DEAD_EXTENT;
+            height += CULL_DEAD_EXTENT;
+        }
+    }
+
+    width *= Abs(e->scale.x);
+    height *= Abs(e->scale.y);
+
+    // The shadow is the same shape flipped below the feet and squashed by the shadow scale
+    float shadow_width = width * Abs(shadow_scale.x);
+    float shadow_height = height * Abs(shadow_scale.y);
+
+    int slot = GetRenderIndex(e);
+    CullEntry& entry = g_cull.entries[slot];
+    entry.entity = e;
+    entry.position = WorldToScreen(e->position);
+    entry.bounds = { entry.position + Vec2{-width, -width}, entry.position + Vec2{width, height + width} };
+    entry.shadow_bounds = { entry.position + Vec2{-shadow_width, -shadow_height - shadow_width}, entry.position + Vec2{shadow_width, shadow_width} };
+    entry.seen = g_cull.frame;
+    g_cull.max_extent = Max(g_cull.max_extent, Max(width + height, shadow_width + shadow_height));
+
+    int bucket = GetCullBucket(GetCullCell(entry.position.x), GetCullCell(entry.position.y));
+    if (bucket == entry.bucket)
+        return;
+
+    if (entry.bucket == -1)
+        g_cull.slots[g_cull.slot_count++] = slot;
+    else
+        UnlinkCullEntry(slot);
+
+    LinkCullEntry(slot, bucket);
+    g_game.stats.cull_moves++;
+}
+
+// Refreshes the entries of every entity in the snapshot and drops the entries of entities that
+// are no longer in it
+static void UpdateCullGrid(const Vec2& shadow_scale) {
+    if (!g_cull.initialized)
+        InitCullGrid();
+
+    g_cull.frame++;
+    g_cull.max_extent = 0.0f;
+
+    int entity_count;
+    Entity** entities = GetRenderEntities(&entity_count);
+    for (int i = 0; i < entity_count; i++)
+        UpdateCullEntry(entities[i], shadow_scale);
+
+    int slot_count = 0;
+    for (int i = 0; i < g_cull.slot_count; i++) {
+        int slot = g_cull.slots[i];
+        if (g_cull.entries[slot].seen == g_cull.frame)
+            g_cull.slots[slot_count++] = slot;
+        else
+            UnlinkCullEntry(slot);
+    }
+
+    g_cull.slot_count = slot_count;
+}
+
+static void AddVisible(CullPass pass, Entity* entity) {
+    g_cull.visible[pass][g_cull.visible_count[pass]++] = entity;
+}
+
+// Fills the visible lists of both passes for the given view.  Buckets can be shared by several
+// cells under the view, so entries are stamped to be tested only once.
+void CullEntities(const Bounds2& view_bounds, const Vec2& shadow_scale) {
+    UpdateCullGrid(shadow_scale);
+
+    for (int pass = 0; pass < CULL_PASS_COUNT; pass++)
+        g_cull.visible_count[pass] = 0;
+
+    g_cull.query++;
+
+    float extent = g_cull.max_extent;
+    int min_x = GetCullCell(view_bounds.min.x - extent);
+    int max_x = GetCullCell(view_bounds.max.x + extent);
+    int min_y = GetCullCell(view_bounds.min.y - extent);
+    int max_y = GetCullCell(view_bounds.max.y + extent);
+
+    for (int cell_y = min_y; cell_y <= max_y; cell_y++) {
+        for (int cell_x = min_x; cell_x <= max_x; cell_x++) {
+            int bucket = GetCullBucket(cell_x, cell_y);
+            for (int slot = g_cull.bucket_head[bucket]; slot != -1; slot = g_cull.entries[slot].next) {
+                CullEntry& entry = g_cull.entries[slot];
+                if (entry.visited == g_cull.query)
+                    continue;
+
+                entry.visited = g_cull.query;
+
+                bool main = CullOverlaps(entry.bounds, view_bounds);
+                bool shadow = CullOverlaps(entry.shadow_bounds, view_bounds);
+                if (main)
+                    AddVisible(CULL_PASS_MAIN, entry.entity);
+                if (shadow)
+                    AddVisible(CULL_PASS_SHADOW, entry.entity);
+                if (main || shadow)
+                    AddVisible(CULL_PASS_ANY, entry.entity);
+            }
+        }
+    }
+
+    g_game.stats.visible_entities = g_cull.visible_count[CULL_PASS_MAIN];
+    g_game.stats.culled_entities = g_cull.slot_count - g_cull.visible_count[CULL_PASS_MAIN];
+    g_game.stats.visible_shadows = g_cull.visible_count[CULL_PASS_SHADOW];
+    g_game.stats.culled_shadows = g_cull.slot_count - g_cull.visible_count[CULL_PASS_SHADOW];
+}
+
+Entity** GetVisibleEntities(CullPass pass, int* count) {
+    assert(pass >= 0 && pass < CULL_PASS_COUNT);
+    *count = g_cull.visible_count[pass];
+    return g_cull.visible[pass];
+}
@@ -0,0 +1,233 @@
+//
+//  Battle TowerZ - Copyright(c) 2025 NoZ Games, LLC
+//
+
+constexpr int MAX_DRAW_RECORDS = 65536;
+constexpr int DRAW_RADIX_BITS = 8;
+constexpr int DRAW_RADIX_BUCKETS = 1 << DRAW_RADIX_BITS;
+
+// Most records one run collects before it is submitted
+constexpr int MAX_DRAW_RUN = 1024;
+
+// Sort key layout, most significant first:
+//   pass (2) | material (6) | depth (24) | entity (12) | layer (6) | mesh (14)
+// Records of equal depth are kept together per entity and drawn in layer order within it, so the
+// parts of overlapping units never interleave.  The mesh only groups equal records into runs.
+constexpr int DRAW_KEY_PASS_SHIFT = 62;
+constexpr int DRAW_KEY_MATERIAL_SHIFT = 56;
+constexpr int DRAW_KEY_DEPTH_SHIFT = 32;
+constexpr int DRAW_KEY_ENTITY_SHIFT = 20;
+constexpr int DRAW_KEY_LAYER_SHIFT = 14;
+constexpr u64 DRAW_KEY_MESH_MASK = (1ull << DRAW_KEY_LAYER_SHIFT) - 1;
+
+static_assert(MAX_ENTITIES <= 1 << (DRAW_KEY_DEPTH_SHIFT - DRAW_KEY_ENTITY_SHIFT), "entity index does not fit the draw key");
+static_assert(MAX_DRAW_LAYERS <= 1 << (DRAW_KEY_ENTITY_SHIFT - DRAW_KEY_LAYER_SHIFT), "layer does not fit the draw key");
+
+struct DrawRecord {
+    Mesh* mesh;
+    Material* material;
+    Mat3 transform;
+    Color color;
+    Vec2 color_offset;
+    float depth;
+};
+
+// Entity draw functions do not bind state or draw directly.  They add records to a per frame list
+// that is radix sorted by a packed key and submitted in order, binding only the state that changes
+// between consecutive records.  Equal keys keep their submission order since the sort is stable.
+// Consecutive records of the same mesh and state are collected into one run, which is what a single
+// instanced draw would submit.
+struct DrawList {
+    DrawRecord records[MAX_DRAW_RECORDS];
+    u64 keys[MAX_DRAW_RECORDS];
+    u64 sorted_keys[MAX_DRAW_RECORDS];
+    u16 order[MAX_DRAW_RECORDS];
+    u16 sorted_order[MAX_DRAW_RECORDS];
+    Material* materials[1 << 6];
+    int material_count;
+    int count;
+    Mat3 run[MAX_DRAW_RUN];
+    Mesh* run_mesh;
+    int run_count;
+};
+
+static_assert(MAX_DRAW_RECORDS <= 65536, "draw record indices are 16 bit");
+
+static DrawList g_draw_list = {};
+
+static u64 GetMaterialKey(Material* material) {
+    for (int i = 0; i < g_draw_list.material_count; i++)
+        if (g_draw_list.materials[i] == material)
+            return static_cast<u64>(i);
+
+    if (g_draw_list.material_count >= static_cast<int>(sizeof(g_draw_list.materials) / sizeof(Material*)))
+        return 0;
+
+    g_draw_list.materials[g_draw_list.material_count] = material;
+    return static_cast<u64>(g_draw_list.material_count++);
+}
+
+// Maps the float to an unsigned value with the same ordering and keeps the top 24 bits
+static u64 GetDepthKey(float depth) {
+    u32 bits;
+    memcpy(&bits, &depth, sizeof(bits));
+    bits = (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+    return static_cast<u64>(bits >> 8);
+}
+
+static u64 HashDrawKey(const void* data, size_t size) {
+    const u8* bytes = static_cast<const u8*>(data);
+    u32 hash = 2166136261u;
+    for (size_t i = 0; i < size; i++)
+        hash = (hash ^ bytes[i]) * 16777619u;
+    return static_cast<u64>(hash ^ (hash >> 16));
+}
+
+u64 GetDrawKey(DrawPass pass, int material, float depth, int entity, int layer, Mesh* mesh) {
+    assert(entity >= 0 && entity < MAX_ENTITIES);
+    assert(layer >= 0 && layer < MAX_DRAW_LAYERS);
+    return
+        (static_cast<u64>(pass) << DRAW_KEY_PASS_SHIFT) |
+        (static_cast<u64>(material) << DRAW_KEY_MATERIAL_SHIFT) |
+        (GetDepthKey(depth) << DRAW_KEY_DEPTH_SHIFT) |
+        (static_cast<u64>(entity) << DRAW_KEY_ENTITY_SHIFT) |
+        (static_cast<u64>(layer) << DRAW_KEY_LAYER_SHIFT) |
+        (HashDrawKey(&mesh, sizeof(mesh)) & DRAW_KEY_MESH_MASK);
+}
+
+void AddDraw(DrawPass pass, Material* material, Mesh* mesh, const Mat3& transform, float depth, const Color& color, const Vec2& color_offset, int entity, int layer) {
+    assert(mesh && material);
+    if (g_draw_list.count >= MAX_DRAW_RECORDS)
+        return;
+
+    int index = g_draw_list.count++;
+    DrawRecord& record = g_draw_list.records[index];
+    record.mesh = mesh;
+    record.material = material;
+    record.transform = transform;
+    record.color = color;
+    record.color_offset = color_offset;
+    record.depth = depth;
+
+    g_draw_list.keys[index] = GetDrawKey(pass, static_cast<int>(GetMaterialKey(material)), depth, entity, layer, mesh);
+    g_draw_list.order[index] = static_cast<u16>(index);
+}
+
+void AddShadowDraw(Mesh* mesh, const Mat3& transform) {
+    AddDraw(DRAW_PASS_SHADOW, g_game.shadow_material, mesh, transform, SHADOW_DEPTH, SHADOW_COLOR);
+}
+
+// Least significant digit first, skipping digits that are the same for every key.  Records with
+// equal keys keep their order and the result is left in keys and order.
+void SortDrawKeys(u64* keys, u16* order, u64* scratch_keys, u16* scratch_order, int count) {
+    if (count <= 1)
+        return;
+
+    u64* src_keys = keys;
+    u64* dst_keys = scratch_keys;
+    u16* src_order = order;
+    u16* dst_order = scratch_order;
+
+    for (int shift = 0; shift < 64; shift += DRAW_RADIX_BITS) {
+        int histogram[DRAW_RADIX_BUCKETS] = {};
+        for (int i = 0; i < count; i++)
+            histogram[(src_keys[i] >> shift) & (DRAW_RADIX_BUCKETS - 1)]++;
+
+        if (histogram[(src_keys[0] >> shift) & (DRAW_RADIX_BUCKETS - 1)] == count)
+            continue;
+
+        int offset = 0;
+        for (int bucket = 0; bucket < DRAW_RADIX_BUCKETS; bucket++) {
+            int bucket_count = histogram[bucket];
+            histogram[bucket] = offset;
+            offset += bucket_count;
+        }
+
+        for (int i = 0; i < count; i++) {
+            int index = histogram[(src_keys[i] >> shift) & (DRAW_RADIX_BUCKETS - 1)]++;
+            dst_keys[index] = src_keys[i];
+            dst_order[index] = src_order[i];
+        }
+
+        u64* swap_keys = src_keys;
+        src_keys = dst_keys;
+        dst_keys = swap_keys;
+
+        u16* swap_order = src_order;
+        src_order = dst_order;
+        dst_order = swap_order;
+    }
+
+    if (src_keys != keys) {
+        memcpy(keys, src_keys, sizeof(u64) * count);
+        memcpy(order, src_order, sizeof(u16) * count);
+    }
+}
+
+// Submits every transform of the run.  The engine has no instanced draw call so each record is
+// still its own DrawMesh, draw_runs counts how many draws instancing would leave.
+static void FlushDrawRun() {
+    if (g_draw_list.run_count == 0)
+        return;
+
+    for (int i = 0; i < g_draw_list.run_count; i++)
+        DrawMesh(g_draw_list.run_mesh, g_draw_list.run[i]);
+
+    g_game.stats.draw_calls += g_draw_list.run_count;
+    g_game.stats.draw_runs++;
+    g_draw_list.run_count = 0;
+}
+
+void FlushDrawList() {
+    int count = g_draw_list.count;
+    if (count == 0)
+        return;
+
+    SortDrawKeys(g_draw_list.keys, g_draw_list.order, g_draw_list.sorted_keys, g_draw_list.sorted_order, count);
+
+    Material* material = nullptr;
+    float depth = F32_MAX;
+    Color color = {};
+    Vec2 color_offset = {};
+    bool color_bound = false;
+    g_draw_list.run_mesh = nullptr;
+    for (int i = 0; i < count; i++) {
+        const DrawRecord& record = g_draw_list.records[g_draw_list.order[i]];
+        bool color_changed = !color_bound || memcmp(&record.color, &color, sizeof(Color)) != 0 || record.color_offset != color_offset;
+        if (record.mesh != g_draw_list.run_mesh ||
+            record.material != material ||
+            record.depth != depth ||
+            color_changed ||
+            g_draw_list.run_count >= MAX_DRAW_RUN)
+            FlushDrawRun();
+
+        if (record.material != material) {
+            material = record.material;
+            BindMaterial(material);
+            g_game.stats.draw_binds++;
+        }
+
+        if (record.depth != depth) {
+            depth = record.depth;
+            BindDepth(depth);
+            g_game.stats.draw_binds++;
+        }
+
+        if (color_changed) {
+            color = record.color;
+            color_offset = record.color_offset;
+            color_bound = true;
+            BindColor(color, color_offset);
+            g_game.stats.draw_binds++;
+        }
+
+        g_draw_list.run_mesh = record.mesh;
+        g_draw_list.run[g_draw_list.run_count++] = record.transform;
+    }
+
+    FlushDrawRun();
+    BindDepth(0.0f);
+    g_game.stats.draw_records += count;
+    g_draw_list.count = 0;
+    g_draw_list.material_count = 0;
+}
@@ -0,0 +1,138 @@
+//
+//  Battle TowerZ - Copyright(c) 2025 NoZ Games, LLC
+//
+
+#include "test.h"
+
+constexpr int DRAW_LIST_TEST_COUNT = 4096;
+
+struct DrawListTestData {
+    u64 keys[DRAW_LIST_TEST_COUNT];
+    u64 input[DRAW_LIST_TEST_COUNT];
+    u16 order[DRAW_LIST_TEST_COUNT];
+    u64 scratch_keys[DRAW_LIST_TEST_COUNT];
+    u16 scratch_order[DRAW_LIST_TEST_COUNT];
+};
+
+static DrawListTestData g_draw_list_test = {};
+
+// Fixed seed so a failure always reproduces
+static u64 NextTestKey(u64& state) {
+    state = state * 6364136223846793005ull + 1442695040888963407ull;
+    return state;
+}
+
+static void SortTestKeys(int count) {
+    DrawListTestData& data = g_draw_list_test;
+    for (int i = 0; i < count; i++) {
+        data.input[i] = data.keys[i];
+        data.order[i] = static_cast<u16>(i);
+    }
+
+    SortDrawKeys(data.keys, data.order, data.scratch_keys, data.scratch_order, count);
+}
+
+// Sorted ascending, every record present once and equal keys still in submission order
+static bool IsSortedStable(int count) {
+    DrawListTestData& data = g_draw_list_test;
+    bool seen[DRAW_LIST_TEST_COUNT] = {};
+    for (int i = 0; i < count; i++) {
+        u16 index = data.order[i];
+        if (seen[index] || data.input[index] != data.keys[i])
+            return false;
+        seen[index] = true;
+
+        if (i > 0 && data.keys[i - 1] > data.keys[i])
+            return false;
+        if (i > 0 && data.keys[i - 1] == data.keys[i] && data.order[i - 1] > index)
+            return false;
+    }
+    return true;
+}
+
+TEST(DrawListSortsRandomKeys) {
+    u64 state = 1;
+    for (int i = 0; i < DRAW_LIST_TEST_COUNT; i++)
+        g_draw_list_test.keys[i] = NextTestKey(state);
+
+    SortTestKeys(DRAW_LIST_TEST_COUNT);
+    EXPECT(IsSortedStable(DRAW_LIST_TEST_COUNT));
+}
+
+// Few distinct keys spread over the high and low digits, most records tie with many others
+TEST(DrawListKeepsEqualKeysInOrder) {
+    u64 state = 7;
+    for (int i = 0; i < DRAW_LIST_TEST_COUNT; i++) {
+        u64 value = NextTestKey(state) >> 61;
+        g_draw_list_test.keys[i] = (value << 62) | (value & 1);
+    }
+
+    SortTestKeys(DRAW_LIST_TEST_COUNT);
+    EXPECT(IsSortedStable(DRAW_LIST_TEST_COUNT));
+}
+
+// Only one digit differs so a single pass runs and the result has to be copied back
+TEST(DrawListSortsSingleDigit) {
+    u64 state = 3;
+    for (int i = 0; i < DRAW_LIST_TEST_COUNT; i++)
+        g_draw_list_test.keys[i] = 0xABCD000000000000ull | (NextTestKey(state) >> 56);
+
+    SortTestKeys(DRAW_LIST_TEST_COUNT);
+    EXPECT(IsSortedStable(DRAW_LIST_TEST_COUNT));
+}
+
+TEST(DrawListSortsTinyLists) {
+    SortTestKeys(0);
+
+    g_draw_list_test.keys[0] = 5;
+    SortTestKeys(1);
+    EXPECT(g_draw_list_test.keys[0] == 5 && g_draw_list_test.order[0] == 0);
+
+    g_draw_list_test.keys[0] = 9;
+    g_draw_list_test.keys[1] = 2;
+    SortTestKeys(2);
+    EXPECT(g_draw_list_test.keys[0] == 2 && g_draw_list_test.order[0] == 1);
+    EXPECT(g_draw_list_test.keys[1] == 9 && g_draw_list_test.order[1] == 0);
+}
+
+// Two units of sixteen parts each, submitted part by part in turn the way overlapping units
+// reach the list.  Each unit has to come out whole and in layer order.
+constexpr int DRAW_LIST_TEST_PARTS = 16;
+
+static int g_draw_list_test_meshes[DRAW_LIST_TEST_PARTS] = {};
+
+static void AddTestUnits(const Vec3& a, int a_entity, const Vec3& b, int b_entity) {
+    DrawListTestData& data = g_draw_list_test;
+    for (int layer = 0; layer < DRAW_LIST_TEST_PARTS; layer++) {
+        Mesh* mesh = reinterpret_cast<Mesh*>(&g_draw_list_test_meshes[layer]);
+        data.keys[layer * 2 + 0] = GetDrawKey(DRAW_PASS_MAIN, 0, GetEntityDepth(a), a_entity, layer, mesh);
+        data.keys[layer * 2 + 1] = GetDrawKey(DRAW_PASS_MAIN, 0, GetEntityDepth(b), b_entity, layer, mesh);
+    }
+
+    SortTestKeys(DRAW_LIST_TEST_PARTS * 2);
+}
+
+// Even submission indices are unit a, odd ones unit b
+static bool IsDrawnWhole(bool a_first) {
+    for (int i = 0; i < DRAW_LIST_TEST_PARTS * 2; i++) {
+        int expected_unit = (i < DRAW_LIST_TEST_PARTS) == a_first ? 0 : 1;
+        int expected_layer = i % DRAW_LIST_TEST_PARTS;
+        if (g_draw_list_test.order[i] != expected_layer * 2 + expected_unit)
+            return false;
+    }
+    return true;
+}
+
+TEST(DrawListKeepsOverlappingUnitsApart) {
+    AddTestUnits(Vec3{0.0f, 0.0f, 1.0f}, 7, Vec3{0.2f, 0.0f, 1.0f}, 3);
+    EXPECT(IsDrawnWhole(false));
+}
+
+// The unit further back is drawn first whatever its index
+TEST(DrawListDrawsBackUnitFirst) {
+    AddTestUnits(Vec3{0.0f, 0.0f, 1.0f}, 3, Vec3{0.0f, 0.0f, 1.1f}, 7);
+    EXPECT(IsDrawnWhole(false));
+
+    AddTestUnits(Vec3{0.0f, 0.0f, 1.1f}, 3, Vec3{0.0f, 0.0f, 1.0f}, 7);
+    EXPECT(IsDrawnWhole(true));
+}
@@ -17,10 +17,50 @@ struct Editor {
     EditorUnit units[MAX_UNITS];
     int unit_count;
     InputSet* input;
+    Mesh* team_line_meshes[TEAM_COUNT];
 };
 
 static Editor g_editor = {};
 
+constexpr int EDITOR_TEAM_LINE_MIN_Y = -20;
+constexpr int EDITOR_TEAM_LINE_MAX_Y = 20;
+
+// Every team line of one side is built from MESH_TEAM_LINE into a single mesh so the side costs
+// one draw.  Red lines are mirrored to the left of the center line.
+static Mesh* CreateTeamLineMesh(Team team) {
+    constexpr int line_count = EDITOR_TEAM_LINE_MAX_Y - EDITOR_TEAM_LINE_MIN_Y + 1;
+
+    float direction = team == TEAM_RED ? -1.0f : 1.0f;
+    const MeshVertex* vertices = GetVertices(MESH_TEAM_LINE);
+    const u16* indices = GetIndices(MESH_TEAM_LINE);
+    int vertex_count = GetVertexCount(MESH_TEAM_LINE);
+    int index_count = GetIndexCount(MESH_TEAM_LINE);
+    assert(line_count * vertex_count <= 65536);
+
+    PushScratch();
+    MeshBuilder* builder = CreateMeshBuilder(ALLOCATOR_SCRATCH, line_count * vertex_count, line_count * index_count);
+    u16 base = 0;
+    for (int y = EDITOR_TEAM_LINE_MIN_Y; y <= EDITOR_TEAM_LINE_MAX_Y; ++y) {
+        for (int i = 0; i < vertex_count; ++i) {
+            const Vec2& point = vertices[i].position;
+            AddVertex(builder, Vec2{point.x * direction, y + point.y}, vertices[i].uv0);
+        }
+
+        for (int i = 0; i < index_count; i += 3)
+            AddTriangle(
+                builder,
+                static_cast<u16>(base + indices[i + 0]),
+                static_cast<u16>(base + indices[i + 1]),
+                static_cast<u16>(base + indices[i + 2]));
+
+        base += static_cast<u16>(vertex_count);
+    }
+
+    Mesh* mesh = CreateMesh(ALLOCATOR_DEFAULT, builder, NAME_NONE, true);
+    PopScratch();
+    return mesh;
+}
+
 static void HandleTapUnit(const UnitInfo* unit_info) {
     g_editor.selected_unit = unit_info->type;
 }
@@ -39,11 +79,9 @@ void DrawEditor() {
     BindDepth(-9.5f);
     BindMaterial(g_game.material);
     BindColor(SetAlpha(COLOR_WHITE, 0.9f), GetTeamColorOffset(TEAM_RED));
-    for (int y=-20; y<=20; ++y)
-        DrawMesh(MESH_TEAM_LINE, TRS(Vec2{0, (float)y }, 0, Vec2{-1, 1}));
+    DrawMesh(g_editor.team_line_meshes[TEAM_RED], Translate(VEC2_ZERO));
     BindColor(SetAlpha(COLOR_WHITE, 0.9f), GetTeamColorOffset(TEAM_BLUE));
-    for (int y=-20; y<=20; ++y)
-        DrawMesh(MESH_TEAM_LINE, TRS(Vec2{0, (float)y }, 0, Vec2{1, 1}));
+    DrawMesh(g_editor.team_line_meshes[TEAM_BLUE], Translate(VEC2_ZERO));
 
     BindDepth(0.0f);
     DrawGrid(g_game.camera);
@@ -209,6 +247,8 @@ void ShutdownEditor() {
     PopInputSet();
     DestroyAllEntities();
     Free(g_editor.input);
+    for (Mesh* mesh : g_editor.team_line_meshes)
+        Free(mesh);
     g_editor = {};
 }
 
@@ -221,6 +261,9 @@ void InitEditor() {
     EnableButton(g_editor.input, MOUSE_LEFT);
     EnableButton(g_editor.input, MOUSE_RIGHT);
 
+    for (int team = 0; team < TEAM_COUNT; team++)
+        g_editor.team_line_meshes[team] = CreateTeamLineMesh(static_cast<Team>(team));
+
     ResetCamera();
     DestroyAllEntities();
     SetGameTimeScale(0.0f);
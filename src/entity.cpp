@@ -6,10 +6,6 @@
 
 static u32 g_next_entity_generation = 1;
 
-void UpdateAnimator(Entity* entity) {
-    Update(entity->animator);
-}
-
 void DestroyAllEntities() {
     Clear(g_game.entity_allocator);
 }
@@ -26,6 +22,13 @@ Entity* CreateEntity(EntityType type, const EntityVtable& vtable, const Vec3& po
     e->position = position;
     e->rotation = rotation;
     e->scale = scale;
+    e->bones = e->animator.bones;
+    e->world_bones = nullptr;
+    e->shadow_bones = nullptr;
+    e->impostor = nullptr;
+    e->impostor_lod = false;
+    e->animation_lod = ANIMATION_LOD_FULL;
+    e->animation_delay = 0.0f;
     e->generation = g_next_entity_generation++;
     return e;
 }
@@ -16,6 +16,14 @@ enum EntityType {
     ENTITY_TYPE_COUNT
 };
 
+enum AnimationLod {
+    ANIMATION_LOD_FULL,
+    ANIMATION_LOD_HALF,
+    ANIMATION_LOD_QUARTER,
+    ANIMATION_LOD_FROZEN,
+    ANIMATION_LOD_COUNT
+};
+
 struct Entity;
 
 struct EntityVtable {
@@ -23,6 +31,7 @@ struct EntityVtable {
     void (*draw)(Entity* entity, const Mat3& transform);
     void (*draw_shadow)(Entity* entity, const Mat3& transform);
     void (*death)(Entity* entity, DamageType damage_type);
+    void (*bake)(Entity* entity, const Mat3& transform);
 };
 
 struct Entity {
@@ -33,6 +42,13 @@ struct Entity {
     float depth;
     float rotation;
     Animator animator;
+    const Mat3* bones;
+    const Mat3* world_bones;
+    const Mat3* shadow_bones;
+    Mesh* impostor;
+    bool impostor_lod;
+    AnimationLod animation_lod;
+    float animation_delay;
     uint32_t generation;
 };
 
@@ -63,7 +79,18 @@ union FatEntity {
 
 // @entity
 extern Entity* CreateEntity(EntityType type, const EntityVtable& vtable, const Vec3& position = VEC3_ZERO, float rotation=0.0f, const Vec2& scale=VEC2_ONE);
-extern void UpdateAnimator(Entity* entity);
 extern void DestroyAllEntities();
 inline Vec2 WorldToScreen(const Vec3& pos) { return XZ(pos) + Vec2{0.0f, pos.y}; }
+inline Mat3 GetEntityTransform(Entity* e) { return TRS(WorldToScreen(e->position), e->rotation, e->scale); }
+
+// Draw depth of an entity standing at the position, entities further back are drawn first
+inline float GetEntityDepth(const Vec3& pos) { return 2.0f - pos.z / 10.0f; }
+
+// @animation
+extern void BeginAnimationFrame();
+extern void UpdateAnimator(Entity* entity, float height);
+extern void BakeUnitAnimations();
+extern void ClearBakedAnimations();
+extern void ReportBakedAnimations();
+extern void UpdateWorldBones(const Vec2& shadow_scale);
 
@@ -21,6 +21,10 @@ constexpr int UI_REF_WIDTH = 1920;
 constexpr int UI_REF_HEIGHT = 1080;
 
 constexpr int WORLD_MAX_TILES = 1024;
+constexpr int WORLD_TILES_X = 32;
+constexpr int WORLD_TILES_Y = WORLD_MAX_TILES / WORLD_TILES_X;
+constexpr float WORLD_TILE_SIZE = 4.0f;
+constexpr Vec2 WORLD_TILES_MIN = {-WORLD_TILE_SIZE * WORLD_TILES_X * 0.5f, -WORLD_TILE_SIZE * WORLD_TILES_Y * 0.5f};
 
 constexpr float MAX_FALL_SPEED = 100.0f;
 
@@ -53,6 +57,46 @@ struct BattleSetup {
     int unit_count;
 };
 
+// Per frame counters, reset at the start of every frame
+struct FrameStats {
+    int animators[ANIMATION_LOD_COUNT];
+    int animators_evaluated[ANIMATION_LOD_COUNT];
+    int baked_samples;
+    int world_bone_units;
+    int draw_records;
+
+    // DrawMesh calls made by the draw list, one per record since the engine has no instanced draw
+    int draw_calls;
+
+    // Runs of consecutive records with the same mesh and state, the draws instancing would leave
+    int draw_runs;
+    int draw_binds;
+    int impostors;
+    int visible_entities;
+    int culled_entities;
+    int visible_shadows;
+    int culled_shadows;
+    int cull_moves;
+    int overlay_units;
+    int overlay_rebuilds;
+    int vfx_spawned;
+    int vfx_merged;
+    int vfx_dropped;
+    int sound_requests;
+    int sound_voices;
+    int sound_coalesced;
+    int sound_stolen;
+    int sound_dropped;
+    int ground_draws;
+    float ui_update_time;
+    float ui_draw_time;
+
+    // Summed over every unit, so a pair of units touching counts twice
+    int separation_contacts;
+    float separation_penetration;
+    float separation_residual;
+};
+
 struct Game {
     Allocator* scene_allocator;
 
@@ -72,6 +116,9 @@ struct Game {
     PoolAllocator* entity_allocator;
 
     bool quit;
+    bool show_overlay;
+    bool show_influence;
+    bool show_stats;
 
     Vec2 mouse_position;
     Vec2 pan_position;
@@ -81,6 +128,9 @@ struct Game {
     BattleSetup battle_setup;
 
     float time_scale;
+
+    u32 frame_index;
+    FrameStats stats;
 };
 
 extern Game g_game;
@@ -98,16 +148,157 @@ extern void ResetCamera();
 extern void SetGameTimeScale(float time_scale);
 inline float GetGameTimeScale() { return g_game.time_scale; }
 
+// @jobs
+typedef void (*JobFunc)(int start, int end, void* user_data);
+extern void InitJobs();
+extern void ShutdownJobs();
+extern void RunParallel(JobFunc func, int count, int batch_size, void* user_data);
+
+// @separation
+extern void UpdateSeparation();
+extern void SeparateDiscs(Vec2* positions, const float* radii, int count);
+
+// @vfx
+enum VfxPriority {
+    VFX_PRIORITY_LOW,
+    VFX_PRIORITY_HIGH
+};
+
+extern void PlayVfx(Vfx* vfx, const Vec2& position, VfxPriority priority = VFX_PRIORITY_LOW);
+extern void UpdateVfx();
+extern void FlushVfx();
+extern void ClearVfx();
+
+// @audio
+typedef SoundHandle (*AudioPlayFunc)(Sound* sound, float volume, float pitch);
+typedef void (*AudioStopFunc)(const SoundHandle& handle);
+extern void InitAudio();
+extern void ClearAudio();
+extern void PlaySoundAt(Sound* sound, const Vec2& position, float volume = 1.0f, float pitch = 1.0f);
+extern void UpdateAudio(const Vec2& listener, float frame_time);
+extern void SetAudioPlayFunc(AudioPlayFunc play_func, AudioStopFunc stop_func);
+extern float GetSoundAttenuation(const Vec2& listener, const Vec2& position);
+extern float GetCoalescedVolume(float volume, int count);
+
+// @simulation
+extern void InitSimulation();
+extern void ShutdownSimulation();
+extern void StartSimulation();
+extern void WaitForSimulation();
+extern void AcquireRenderSnapshot();
+extern void ClearRenderSnapshots();
+extern Entity** GetRenderEntities(int* count);
+extern int GetRenderIndex(Entity* entity);
+extern void TriggerVfx(Vfx* vfx, const Vec2& position, VfxPriority priority = VFX_PRIORITY_LOW);
+extern void TriggerSound(Sound* sound, const Vec2& position, float volume = 1.0f, float pitch = 1.0f);
+
 // @world
 extern void InitWorld();
 extern void DrawWorld(Camera* camera);
 extern void DrawGrid(Camera* camera);
+extern void UpdateFlowFields(float dt);
+extern void BuildFlowField(Team team, const int* enemy_counts);
+extern Vec2 SampleFlowField(Team team, const Vec2& position);
+extern void ClearFlowFields();
+extern void UpdateInfluenceMaps();
+extern bool EnumerateUnitsInRing(Team team, const Vec2& position, int ring, bool (*callback)(UnitEntity* unit, void* user_data), void* user_data);
+extern void CommitInfluenceMaps();
+extern void DrawInfluenceMaps();
+extern float GetThreat(Team team, const Vec2& position);
+extern float GetInfluenceBalance(Team team, const Vec2& position);
+extern float GetDensity(Team team, const Vec2& position);
+extern void AddStaticObstacle(const Vec2& position, float radius, const EntityHandle& entity);
+extern void RemoveStaticObstacle(const EntityHandle& entity);
+extern void EnumerateStaticUnits(Team team, bool (*callback)(UnitEntity* unit, void* user_data), void* user_data);
+extern void ClearStaticObstacles();
+extern void BuildObstacleField();
+extern float GetObstacleDistance(const Vec2& position);
+extern Vec2 GetObstacleNormal(const Vec2& position);
+extern bool HasLineOfSight(const Vec2& from, const Vec2& to, float clearance = 0.0f);
+
+// @ground
+enum DecalType {
+    DECAL_TYPE_ARROW,
+    DECAL_TYPE_BLOOD,
+    DECAL_TYPE_SCORCH,
+    DECAL_TYPE_COUNT
+};
+
+extern void InitGround();
+extern void AddGroundMesh(Mesh** mesh, const Mat3& transform, Team team);
+extern void CommitGround();
+extern void AddGroundDecal(DecalType type, const Vec2& position, float rotation, float scale, Team team);
+extern void ClearGround();
+extern void DrawGround();
+
+// @culling
+enum CullPass {
+    CULL_PASS_MAIN,
+    CULL_PASS_SHADOW,
+    CULL_PASS_ANY,
+    CULL_PASS_COUNT
+};
+
+extern void CullEntities(const Bounds2& view_bounds, const Vec2& shadow_scale);
+extern Entity** GetVisibleEntities(CullPass pass, int* count);
+
+// @draw_list
+enum DrawPass {
+    DRAW_PASS_SHADOW,
+    DRAW_PASS_MAIN,
+    DRAW_PASS_COUNT
+};
+
+// Records of equal depth are drawn by entity and then in layer order, entities made of several
+// meshes pass their render index and number their parts back to front
+constexpr int MAX_DRAW_LAYERS = 64;
+
+extern void AddDraw(DrawPass pass, Material* material, Mesh* mesh, const Mat3& transform, float depth, const Color& color, const Vec2& color_offset = VEC2_ZERO, int entity = 0, int layer = 0);
+extern u64 GetDrawKey(DrawPass pass, int material, float depth, int entity, int layer, Mesh* mesh);
+extern void AddShadowDraw(Mesh* mesh, const Mat3& transform);
+extern void FlushDrawList();
+extern void SortDrawKeys(u64* keys, u16* order, u64* scratch_keys, u16* scratch_order, int count);
+
+// @overlay
+extern void InitOverlay();
+extern void DrawOverlay();
+extern void ShutdownOverlay();
+
+// @skinning
+constexpr int MAX_SKINNED_BONES = 32;
+constexpr int BONE_PALETTE_STRIDE = 8;
+
+// Remap entry of a bone that has no palette slot
+constexpr u8 SKINNED_BONE_INVALID = 0xFF;
+
+struct SkinnedVertex {
+    Vec2 position;
+    Vec2 uv;
+    u8 bone;
+};
+
+// Source part of a skinned mesh, rigidly attached to one bone
+struct SkinnedPart {
+    const Vec2* positions;
+    const Vec2* uvs;
+    int vertex_count;
+    const u16* indices;
+    int index_count;
+    int bone;
+};
+
+extern bool MergeSkinnedParts(const SkinnedPart* parts, int part_count, const u8* remap, SkinnedVertex* vertices, int max_vertices, int* vertex_count, u16* indices, int max_indices, int* index_count);
+extern int PackBonePalette(const Mat3* bones, int bone_count, u32 bone_mask, float* palette, u8* remap);
+extern Vec2 SkinVertex(const SkinnedVertex& vertex, const float* palette);
 
 // @colors
 constexpr Color BACKGROUND_COLOR = Color32ToColor(220,220,220,255);
 constexpr Color VIGNETTE_COLOR = Color32ToColor(210,210,210,255);
 constexpr Color FOREGROUND_COLOR = Color32ToColor(88,88,88,255);
 constexpr Color HOVER_COLOR = Color32ToColor(85, 177, 241,255);
+constexpr Color SHADOW_COLOR = {0,0,0,0.1f};
+constexpr Vec2 SHADOW_SCALE = {1.0f, -0.5f};
+constexpr float SHADOW_DEPTH = -7.0f;
 constexpr Color GRID_COLOR = {0.4f, 0.4f, 0.4f, 0.1f};
 constexpr Color UI_LETTERBOX_COLOR = {0.3f, 0.3f, 0.3f, 1.0f};
 constexpr Color UI_LETTERBOX_BORDER_COLOR = {0.1f, 0.1f, 0.1f, 1.0f};
@@ -133,6 +324,7 @@ extern void OpenBattle(const BattleSetup& setup);
 extern void InitBattle();
 extern void ShutdownBattle();
 extern void UpdateBattle();
+extern void SimulateBattle();
 extern void UpdateBattleUI();
 extern void DrawBattle();
 extern void HandleUnitDeath(UnitEntity* entity, DamageType damage_type);
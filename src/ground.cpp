@@ -0,0 +1,510 @@
+//
+//  Battle TowerZ - Copyright(c) 2025 NoZ Games, LLC
+//
+
+constexpr float GROUND_DEPTH = -8.0f;
+constexpr float DECAL_DEPTH = -8.5f;
+
+// Corpse parts and decals are kept in a grid of tiles over the battle area, each drawn as one mesh
+constexpr float GROUND_TILE_SIZE = 8.0f;
+constexpr int GROUND_TILES_X = 16;
+constexpr int GROUND_TILES_Y = 8;
+constexpr Vec2 GROUND_GRID_MIN = {-GROUND_TILE_SIZE * GROUND_TILES_X * 0.5f, -GROUND_TILE_SIZE * GROUND_TILES_Y * 0.5f};
+
+// Parts stick out of the tile their origin is in by up to this much, tiles are culled with it
+constexpr float GROUND_TILE_MARGIN = 2.0f;
+
+constexpr int MAX_TILE_PARTS = 512;
+constexpr int MAX_PENDING_GROUND_PARTS = 4096;
+constexpr int MAX_GROUND_SHAPES = 32;
+constexpr int MAX_GROUND_SHAPE_VERTICES = 128;
+constexpr int MAX_GROUND_SHAPE_INDICES = 384;
+
+constexpr int MAX_TILE_DECALS = 128;
+constexpr int MAX_PENDING_DECALS = 1024;
+
+// A buried arrow only shows the part of its mesh behind this point on the shaft
+constexpr float DECAL_ARROW_BURY_X = -0.1f;
+
+static_assert(MAX_TILE_PARTS * MAX_GROUND_SHAPE_VERTICES <= 65536, "tile part vertices are 16 bit");
+static_assert(MAX_TILE_DECALS * MAX_GROUND_SHAPE_VERTICES <= 65536, "tile decal vertices are 16 bit");
+
+// Triangles of a loaded mesh in the space of the mesh, kept in the order the mesh draws them so
+// the outlines it carries stay under its faces
+struct GroundShape {
+    Mesh** mesh;
+    Vec2 positions[MAX_GROUND_SHAPE_VERTICES];
+    Vec2 uvs[MAX_GROUND_SHAPE_VERTICES];
+    int vertex_count;
+    u16 indices[MAX_GROUND_SHAPE_INDICES];
+    int index_count;
+};
+
+// Static mesh baked into the ground, already in world space.  Parts whose mesh has no shape are
+// drawn on their own.
+struct GroundPart {
+    Mesh** mesh;
+    Mat3 transform;
+    Team team;
+    int shape;
+};
+
+struct Decal {
+    DecalType type;
+    Vec2 position;
+    float rotation;
+    float scale;
+    Team team;
+};
+
+// Everything in a tile is built into a mesh relative to the tile minimum, one for the corpse parts
+// and one for the decals, which is only rebuilt when something new lands in the tile and the tile
+// is in view.  Both keep a ring of their newest entries, so neither the memory nor the draw cost
+// of the layer grows with the number of bodies or decals.
+struct GroundTile {
+    GroundPart parts[MAX_TILE_PARTS];
+    int part_count;
+    int part_next;
+    int loose_parts;
+    Mesh* part_mesh;
+    bool parts_dirty;
+
+    Decal decals[MAX_TILE_DECALS];
+    int decal_count;
+    int decal_next;
+    Mesh* decal_mesh;
+    bool decals_dirty;
+};
+
+// Parts and decals added by the simulation thread wait in the pending lists until the main thread
+// commits them while the simulation is idle.
+struct GroundLayer {
+    GroundTile tiles[GROUND_TILES_Y][GROUND_TILES_X];
+    GroundShape shapes[MAX_GROUND_SHAPES];
+    int shape_count;
+    GroundShape arrow_decal;
+    GroundPart pending[MAX_PENDING_GROUND_PARTS];
+    int pending_count;
+    Decal pending_decals[MAX_PENDING_DECALS];
+    int pending_decal_count;
+};
+
+static GroundLayer g_ground = {};
+
+// Meshes stamped into the ground tiles, parts of any other mesh are drawn on their own
+static Mesh** const GROUND_MESHES[] = {
+    &MESH_STICK_ARM_L_R,
+    &MESH_STICK_ARM_U_R,
+    &MESH_STICK_ARM_L_L,
+    &MESH_STICK_ARM_U_L,
+    &MESH_STICK_HAND_R,
+    &MESH_STICK_HAND_L,
+    &MESH_STICK_LEG_U_R,
+    &MESH_STICK_LEG_L_R,
+    &MESH_STICK_LEG_L_L,
+    &MESH_STICK_LEG_U_L,
+    &MESH_STICK_HIP,
+    &MESH_STICK_BODY_B,
+    &MESH_STICK_BODY,
+    &MESH_STICK_NECK,
+    &MESH_STICK_HEAD,
+    &MESH_STICK_BOW,
+    &MESH_PROJECTILE_ARROW,
+};
+
+// Irregular splat used for blood and scorch marks, fanned from the first vertex
+static const Vec2 DECAL_SPLAT_VERTICES[] = {
+    { 0.00f,  0.00f}, { 0.50f,  0.05f}, { 0.30f,  0.35f}, {-0.05f,  0.45f}, {-0.40f,  0.30f},
+    {-0.55f, -0.05f}, {-0.30f, -0.30f}, { 0.05f, -0.40f}, { 0.40f, -0.30f},
+};
+
+// Uvs are offset by the team color the same way BindTeamColor shifts a mesh drawn on its own
+static void AddShapeGeometry(MeshBuilder* builder, int* base, const GroundShape& shape, const Mat3& transform, const Vec2& uv_offset) {
+    for (int i = 0; i < shape.vertex_count; i++)
+        AddVertex(builder, TransformPoint(transform, shape.positions[i]), shape.uvs[i] + uv_offset);
+    for (int i = 0; i < shape.index_count; i += 3)
+        AddTriangle(
+            builder,
+            static_cast<u16>(*base + shape.indices[i + 0]),
+            static_cast<u16>(*base + shape.indices[i + 1]),
+            static_cast<u16>(*base + shape.indices[i + 2]));
+    *base += shape.vertex_count;
+}
+
+static int GetDecalVertexCount(DecalType type) {
+    if (type == DECAL_TYPE_ARROW)
+        return g_ground.arrow_decal.vertex_count;
+
+    return sizeof(DECAL_SPLAT_VERTICES) / sizeof(Vec2);
+}
+
+static int GetDecalIndexCount(DecalType type) {
+    if (type == DECAL_TYPE_ARROW)
+        return g_ground.arrow_decal.index_count;
+
+    return (GetDecalVertexCount(type) - 1) * 3;
+}
+
+static Vec2 GetSplatUV(const Decal& decal) {
+    if (decal.type == DECAL_TYPE_BLOOD)
+        return ColorUV(1,3);
+
+    return ColorUV(1,0);
+}
+
+static void AddDecalGeometry(MeshBuilder* builder, int* base, const Decal& decal, const Vec2& tile_min) {
+    Mat3 transform = TRS(decal.position - tile_min, decal.rotation, Vec2{decal.scale, decal.scale});
+    if (decal.type == DECAL_TYPE_ARROW) {
+        AddShapeGeometry(builder, base, g_ground.arrow_decal, transform, GetTeamColorOffset(decal.team));
+        return;
+    }
+
+    Vec2 uv = GetSplatUV(decal);
+    int vertex_count = GetDecalVertexCount(decal.type);
+    for (const Vec2& vertex : DECAL_SPLAT_VERTICES)
+        AddVertex(builder, TransformPoint(transform, vertex), uv);
+    for (int i = 1; i < vertex_count; i++)
+        AddTriangle(
+            builder,
+            static_cast<u16>(*base),
+            static_cast<u16>(*base + i),
+            static_cast<u16>(*base + (i % (vertex_count - 1)) + 1));
+    *base += vertex_count;
+}
+
+static bool GetGroundTile(const Vec2& position, int* tile_x, int* tile_y) {
+    Vec2 cell = (position - GROUND_GRID_MIN) / GROUND_TILE_SIZE;
+    *tile_x = static_cast<int>(floorf(cell.x));
+    *tile_y = static_cast<int>(floorf(cell.y));
+    return *tile_x >= 0 && *tile_x < GROUND_TILES_X && *tile_y >= 0 && *tile_y < GROUND_TILES_Y;
+}
+
+static Vec2 GetGroundTileMin(int tile_x, int tile_y) {
+    return GROUND_GRID_MIN + Vec2{tile_x * GROUND_TILE_SIZE, tile_y * GROUND_TILE_SIZE};
+}
+
+static bool IsGroundTileVisible(const Bounds2& view, int tile_x, int tile_y) {
+    Vec2 min = GetGroundTileMin(tile_x, tile_y) - Vec2{GROUND_TILE_MARGIN, GROUND_TILE_MARGIN};
+    Vec2 max = min + Vec2{GROUND_TILE_SIZE + GROUND_TILE_MARGIN * 2.0f, GROUND_TILE_SIZE + GROUND_TILE_MARGIN * 2.0f};
+    return min.x <= view.max.x && max.x >= view.min.x && min.y <= view.max.y && max.y >= view.min.y;
+}
+
+// Copies the triangles of a loaded mesh, a mesh too large for a shape is left to draw on its own
+static bool CopyGroundShape(GroundShape& shape, Mesh** mesh) {
+    shape.mesh = mesh;
+    shape.vertex_count = 0;
+    shape.index_count = 0;
+    if (!*mesh)
+        return false;
+
+    int vertex_count = GetVertexCount(*mesh);
+    int index_count = GetIndexCount(*mesh);
+    if (vertex_count > MAX_GROUND_SHAPE_VERTICES || index_count > MAX_GROUND_SHAPE_INDICES)
+        return false;
+
+    const MeshVertex* vertices = GetVertices(*mesh);
+    const u16* indices = GetIndices(*mesh);
+    for (int i = 0; i < vertex_count; i++) {
+        shape.positions[i] = vertices[i].position;
+        shape.uvs[i] = vertices[i].uv0;
+    }
+    for (int i = 0; i < index_count; i++)
+        shape.indices[i] = indices[i];
+
+    shape.vertex_count = vertex_count;
+    shape.index_count = index_count;
+    return true;
+}
+
+// Each triangle of the arrow is clipped to the buried line, which leaves at most a quad
+static void BuildArrowDecal() {
+    GroundShape& shape = g_ground.arrow_decal;
+    shape.mesh = &MESH_PROJECTILE_ARROW;
+    shape.vertex_count = 0;
+    shape.index_count = 0;
+    if (!MESH_PROJECTILE_ARROW)
+        return;
+
+    const MeshVertex* vertices = GetVertices(MESH_PROJECTILE_ARROW);
+    const u16* indices = GetIndices(MESH_PROJECTILE_ARROW);
+    int index_count = GetIndexCount(MESH_PROJECTILE_ARROW);
+    for (int i = 0; i < index_count; i += 3) {
+        Vec2 positions[4];
+        Vec2 uvs[4];
+        int count = 0;
+        for (int corner = 0; corner < 3; corner++) {
+            const MeshVertex& a = vertices[indices[i + corner]];
+            const MeshVertex& b = vertices[indices[i + (corner + 1) % 3]];
+            bool a_inside = a.position.x <= DECAL_ARROW_BURY_X;
+            bool b_inside = b.position.x <= DECAL_ARROW_BURY_X;
+            if (a_inside) {
+                positions[count] = a.position;
+                uvs[count++] = a.uv0;
+            }
+            if (a_inside != b_inside) {
+                float t = (DECAL_ARROW_BURY_X - a.position.x) / (b.position.x - a.position.x);
+                positions[count] = a.position + (b.position - a.position) * t;
+                uvs[count++] = a.uv0 + (b.uv0 - a.uv0) * t;
+            }
+        }
+
+        if (count < 3)
+            continue;
+
+        if (shape.vertex_count + count > MAX_GROUND_SHAPE_VERTICES || shape.index_count + (count - 2) * 3 > MAX_GROUND_SHAPE_INDICES)
+            return;
+
+        int base = shape.vertex_count;
+        for (int v = 0; v < count; v++) {
+            shape.positions[base + v] = positions[v];
+            shape.uvs[base + v] = uvs[v];
+        }
+        for (int v = 1; v < count - 1; v++) {
+            shape.indices[shape.index_count++] = static_cast<u16>(base);
+            shape.indices[shape.index_count++] = static_cast<u16>(base + v);
+            shape.indices[shape.index_count++] = static_cast<u16>(base + v + 1);
+        }
+        shape.vertex_count += count;
+    }
+}
+
+static int FindGroundShape(Mesh** mesh) {
+    for (int i = 0; i < g_ground.shape_count; i++)
+        if (g_ground.shapes[i].mesh == mesh)
+            return i;
+
+    return -1;
+}
+
+static const GroundPart& GetTilePart(const GroundTile& tile, int index) {
+    int first = tile.part_count < MAX_TILE_PARTS ? 0 : tile.part_next;
+    return tile.parts[(first + index) % MAX_TILE_PARTS];
+}
+
+// Oldest first so newer bodies land on top
+static void BuildPartTile(GroundTile& tile, const Vec2& tile_min) {
+    if (tile.part_mesh) {
+        Free(tile.part_mesh);
+        tile.part_mesh = nullptr;
+    }
+
+    tile.parts_dirty = false;
+
+    int vertex_count = 0;
+    int index_count = 0;
+    for (int i = 0; i < tile.part_count; i++) {
+        const GroundPart& part = tile.parts[i];
+        if (part.shape == -1)
+            continue;
+
+        vertex_count += g_ground.shapes[part.shape].vertex_count;
+        index_count += g_ground.shapes[part.shape].index_count;
+    }
+
+    if (vertex_count == 0)
+        return;
+
+    PushScratch();
+    MeshBuilder* builder = CreateMeshBuilder(ALLOCATOR_SCRATCH, vertex_count, index_count);
+    int base = 0;
+    for (int i = 0; i < tile.part_count; i++) {
+        const GroundPart& part = GetTilePart(tile, i);
+        if (part.shape != -1)
+            AddShapeGeometry(builder, &base, g_ground.shapes[part.shape], Translate(-tile_min) * part.transform, GetTeamColorOffset(part.team));
+    }
+    tile.part_mesh = CreateMesh(ALLOCATOR_DEFAULT, builder, NAME_NONE, true);
+    PopScratch();
+}
+
+static void BuildDecalTile(GroundTile& tile, const Vec2& tile_min) {
+    if (tile.decal_mesh) {
+        Free(tile.decal_mesh);
+        tile.decal_mesh = nullptr;
+    }
+
+    tile.decals_dirty = false;
+    if (tile.decal_count == 0)
+        return;
+
+    int vertex_count = 0;
+    int index_count = 0;
+    for (int i = 0; i < tile.decal_count; i++) {
+        vertex_count += GetDecalVertexCount(tile.decals[i].type);
+        index_count += GetDecalIndexCount(tile.decals[i].type);
+    }
+
+    PushScratch();
+    MeshBuilder* builder = CreateMeshBuilder(ALLOCATOR_SCRATCH, vertex_count, index_count);
+    int base = 0;
+    for (int i = 0; i < tile.decal_count; i++)
+        AddDecalGeometry(builder, &base, tile.decals[i], tile_min);
+    tile.decal_mesh = CreateMesh(ALLOCATOR_DEFAULT, builder, NAME_NONE, true);
+    PopScratch();
+}
+
+void AddGroundDecal(DecalType type, const Vec2& position, float rotation, float scale, Team team) {
+    if (g_ground.pending_decal_count >= MAX_PENDING_DECALS)
+        return;
+
+    g_ground.pending_decals[g_ground.pending_decal_count++] = { type, position, rotation, scale, team };
+}
+
+void AddGroundMesh(Mesh** mesh, const Mat3& transform, Team team) {
+    assert(mesh);
+    assert(team >= 0 && team < TEAM_COUNT);
+
+    if (g_ground.pending_count >= MAX_PENDING_GROUND_PARTS)
+        return;
+
+    g_ground.pending[g_ground.pending_count++] = { mesh, transform, team, -1 };
+}
+
+// Parts outside the battle area go to the nearest edge tile, decals outside of it are dropped
+void CommitGround() {
+    for (int i = 0; i < g_ground.pending_count; i++) {
+        GroundPart part = g_ground.pending[i];
+        part.shape = FindGroundShape(part.mesh);
+
+        int tile_x;
+        int tile_y;
+        GetGroundTile(TransformPoint(part.transform), &tile_x, &tile_y);
+        GroundTile& tile = g_ground.tiles[Clamp(tile_y, 0, GROUND_TILES_Y - 1)][Clamp(tile_x, 0, GROUND_TILES_X - 1)];
+        GroundPart& slot = tile.parts[tile.part_next];
+        if (tile.part_count == MAX_TILE_PARTS && slot.shape == -1)
+            tile.loose_parts--;
+
+        slot = part;
+        if (part.shape == -1)
+            tile.loose_parts++;
+        tile.part_next = (tile.part_next + 1) % MAX_TILE_PARTS;
+        tile.part_count = Min(tile.part_count + 1, MAX_TILE_PARTS);
+        tile.parts_dirty = true;
+    }
+
+    g_ground.pending_count = 0;
+
+    for (int i = 0; i < g_ground.pending_decal_count; i++) {
+        const Decal& decal = g_ground.pending_decals[i];
+        int tile_x;
+        int tile_y;
+        if (!GetGroundTile(decal.position, &tile_x, &tile_y))
+            continue;
+
+        GroundTile& tile = g_ground.tiles[tile_y][tile_x];
+        tile.decals[tile.decal_next] = decal;
+        tile.decal_next = (tile.decal_next + 1) % MAX_TILE_DECALS;
+        tile.decal_count = Min(tile.decal_count + 1, MAX_TILE_DECALS);
+        tile.decals_dirty = true;
+    }
+
+    g_ground.pending_decal_count = 0;
+}
+
+void ClearGround() {
+    for (int tile_y = 0; tile_y < GROUND_TILES_Y; tile_y++) {
+        for (int tile_x = 0; tile_x < GROUND_TILES_X; tile_x++) {
+            GroundTile& tile = g_ground.tiles[tile_y][tile_x];
+            if (tile.part_mesh)
+                Free(tile.part_mesh);
+            if (tile.decal_mesh)
+                Free(tile.decal_mesh);
+
+            tile.part_mesh = nullptr;
+            tile.part_count = 0;
+            tile.part_next = 0;
+            tile.loose_parts = 0;
+            tile.parts_dirty = false;
+            tile.decal_mesh = nullptr;
+            tile.decal_count = 0;
+            tile.decal_next = 0;
+            tile.decals_dirty = false;
+        }
+    }
+
+    g_ground.pending_count = 0;
+    g_ground.pending_decal_count = 0;
+}
+
+// Parts of meshes without shapes, drawn one by one
+static void DrawLooseParts(const GroundTile& tile) {
+    for (int i = 0; i < tile.part_count; i++) {
+        const GroundPart& part = GetTilePart(tile, i);
+        if (part.shape != -1)
+            continue;
+
+        BindTeamColor(part.team);
+        DrawMesh(*part.mesh, part.transform);
+    }
+
+    BindColor(COLOR_WHITE);
+}
+
+// Only tiles under the view are rebuilt and drawn, a dirty tile out of view waits until it is seen
+void DrawGround() {
+    Bounds2 view = GetBounds(g_game.camera);
+    BindMaterial(g_game.material);
+    BindColor(COLOR_WHITE);
+
+    for (int tile_y = 0; tile_y < GROUND_TILES_Y; tile_y++) {
+        for (int tile_x = 0; tile_x < GROUND_TILES_X; tile_x++) {
+            if (!IsGroundTileVisible(view, tile_x, tile_y))
+                continue;
+
+            GroundTile& tile = g_ground.tiles[tile_y][tile_x];
+            Vec2 tile_min = GetGroundTileMin(tile_x, tile_y);
+            if (tile.decals_dirty)
+                BuildDecalTile(tile, tile_min);
+            if (tile.parts_dirty)
+                BuildPartTile(tile, tile_min);
+
+            if (tile.decal_mesh) {
+                BindDepth(DECAL_DEPTH);
+                DrawMesh(tile.decal_mesh, Translate(tile_min));
+                g_game.stats.ground_draws++;
+            }
+
+            if (tile.part_mesh) {
+                BindDepth(GROUND_DEPTH);
+                DrawMesh(tile.part_mesh, Translate(tile_min));
+                g_game.stats.ground_draws++;
+            }
+
+            if (tile.loose_parts > 0) {
+                BindDepth(GROUND_DEPTH);
+                DrawLooseParts(tile);
+                g_game.stats.ground_draws += tile.loose_parts;
+            }
+        }
+    }
+
+    BindDepth(0.0f);
+}
+
+// Shapes are copied from the loaded meshes, so this runs again after a hotload and every part
+// already on the ground is matched to the new shapes and rebuilt from them
+void InitGround() {
+    g_ground.shape_count = 0;
+    for (Mesh** mesh : GROUND_MESHES) {
+        assert(g_ground.shape_count < MAX_GROUND_SHAPES);
+        if (CopyGroundShape(g_ground.shapes[g_ground.shape_count], mesh))
+            g_ground.shape_count++;
+    }
+
+    BuildArrowDecal();
+
+    for (int tile_y = 0; tile_y < GROUND_TILES_Y; tile_y++) {
+        for (int tile_x = 0; tile_x < GROUND_TILES_X; tile_x++) {
+            GroundTile& tile = g_ground.tiles[tile_y][tile_x];
+            tile.loose_parts = 0;
+            for (int i = 0; i < tile.part_count; i++) {
+                GroundPart& part = tile.parts[i];
+                part.shape = FindGroundShape(part.mesh);
+                if (part.shape == -1)
+                    tile.loose_parts++;
+            }
+
+            tile.parts_dirty = tile.part_count > 0;
+            tile.decals_dirty = tile.decal_count > 0;
+        }
+    }
+}
@@ -0,0 +1,143 @@
+//
+//  Battle TowerZ - Copyright(c) 2025 NoZ Games, LLC
+//
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+constexpr int MAX_JOB_WORKERS = 8;
+
+// Small persistent worker pool used to split per-frame loops (ragdolls, separation, ...) into batches.
+// The calling thread always takes part, so a job never waits on a sleeping worker to make progress.
+struct JobSystem {
+    std::thread workers[MAX_JOB_WORKERS];
+    int worker_count;
+    std::mutex mutex;
+    std::mutex submit;
+    std::condition_variable wake;
+    std::condition_variable done;
+    JobFunc func;
+    void* user_data;
+    int count;
+    int batch_size;
+    int batch_count;
+    u32 generation;
+    int active_workers;
+    std::atomic<int> next_batch;
+    std::atomic<int> remaining_batches;
+    bool quit;
+};
+
+static JobSystem g_jobs = {};
+
+static void RunBatches(JobFunc func, void* user_data, int count, int batch_size, int batch_count) {
+    for (;;) {
+        int batch = g_jobs.next_batch.fetch_add(1);
+        if (batch >= batch_count)
+            return;
+
+        int start = batch * batch_size;
+        int end = Min(start + batch_size, count);
+        func(start, end, user_data);
+
+        if (g_jobs.remaining_batches.fetch_sub(1) == 1) {
+            std::lock_guard<std::mutex> lock(g_jobs.mutex);
+            g_jobs.done.notify_all();
+        }
+    }
+}
+
+static void WorkerThread() {
+    u32 generation = 0;
+    for (;;) {
+        JobFunc func;
+        void* user_data;
+        int count;
+        int batch_size;
+        int batch_count;
+
+        {
+            std::unique_lock<std::mutex> lock(g_jobs.mutex);
+            g_jobs.wake.wait(lock, [generation] { return g_jobs.quit || g_jobs.generation != generation; });
+            if (g_jobs.quit)
+                return;
+
+            generation = g_jobs.generation;
+            func = g_jobs.func;
+            user_data = g_jobs.user_data;
+            count = g_jobs.count;
+            batch_size = g_jobs.batch_size;
+            batch_count = g_jobs.batch_count;
+            g_jobs.active_workers++;
+        }
+
+        RunBatches(func, user_data, count, batch_size, batch_count);
+
+        std::lock_guard<std::mutex> lock(g_jobs.mutex);
+        g_jobs.active_workers--;
+        g_jobs.done.notify_all();
+    }
+}
+
+void RunParallel(JobFunc func, int count, int batch_size, void* user_data) {
+    assert(func);
+    assert(batch_size > 0);
+
+    if (count <= 0)
+        return;
+
+    // Not worth waking anyone for a single batch
+    if (count <= batch_size || g_jobs.worker_count == 0) {
+        func(0, count, user_data);
+        return;
+    }
+
+    int batch_count = (count + batch_size - 1) / batch_size;
+
+    // The simulation and render threads both submit jobs, the pool runs one job at a time
+    std::lock_guard<std::mutex> submit_lock(g_jobs.submit);
+
+    {
+        // A worker that woke up late for the previous job may still be draining it
+        std::unique_lock<std::mutex> lock(g_jobs.mutex);
+        g_jobs.done.wait(lock, [] { return g_jobs.active_workers == 0; });
+        g_jobs.func = func;
+        g_jobs.user_data = user_data;
+        g_jobs.count = count;
+        g_jobs.batch_size = batch_size;
+        g_jobs.batch_count = batch_count;
+        g_jobs.next_batch = 0;
+        g_jobs.remaining_batches = batch_count;
+        g_jobs.generation++;
+    }
+    g_jobs.wake.notify_all();
+
+    RunBatches(func, user_data, count, batch_size, batch_count);
+
+    // Wait for the stragglers to finish their batches and leave the job so the next job can reuse the state
+    std::unique_lock<std::mutex> lock(g_jobs.mutex);
+    g_jobs.done.wait(lock, [] { return g_jobs.remaining_batches == 0 && g_jobs.active_workers == 0; });
+}
+
+void InitJobs() {
+    int hardware_threads = static_cast<int>(std::thread::hardware_concurrency());
+    g_jobs.worker_count = Min(Max(hardware_threads - 1, 0), MAX_JOB_WORKERS);
+    g_jobs.quit = false;
+    for (int i = 0; i < g_jobs.worker_count; i++)
+        g_jobs.workers[i] = std::thread(WorkerThread);
+}
+
+void ShutdownJobs() {
+    {
+        std::lock_guard<std::mutex> lock(g_jobs.mutex);
+        g_jobs.quit = true;
+    }
+    g_jobs.wake.notify_all();
+
+    for (int i = 0; i < g_jobs.worker_count; i++)
+        g_jobs.workers[i].join();
+
+    g_jobs.worker_count = 0;
+}
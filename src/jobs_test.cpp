@@ -0,0 +1,105 @@
+//
+//  Battle TowerZ - Copyright(c) 2025 NoZ Games, LLC
+//
+
+#include <atomic>
+#include <thread>
+#include "test.h"
+
+constexpr int JOBS_TEST_COUNT = 10000;
+constexpr int JOBS_TEST_RUNS = 100;
+
+struct JobsTestData {
+    int visits[JOBS_TEST_COUNT];
+    std::atomic<int> batches;
+};
+
+// Every index belongs to exactly one batch so the plain increments never race
+static void VisitRange(int start, int end, void* user_data) {
+    JobsTestData* data = static_cast<JobsTestData*>(user_data);
+    for (int i = start; i < end; i++)
+        data->visits[i]++;
+    data->batches++;
+}
+
+static bool IsVisitedOnce(const JobsTestData& data, int count) {
+    for (int i = 0; i < count; i++)
+        if (data.visits[i] != 1)
+            return false;
+
+    for (int i = count; i < JOBS_TEST_COUNT; i++)
+        if (data.visits[i] != 0)
+            return false;
+
+    return true;
+}
+
+static void ResetJobsTestData(JobsTestData& data) {
+    for (int& visits : data.visits)
+        visits = 0;
+    data.batches = 0;
+}
+
+TEST(JobsVisitEveryIndexOnce) {
+    static JobsTestData data;
+    InitJobs();
+
+    // Partial last batch, a single batch, and nothing at all
+    const int counts[] = { JOBS_TEST_COUNT, JOBS_TEST_COUNT - 17, 50, 0 };
+    for (int count : counts) {
+        ResetJobsTestData(data);
+        RunParallel(VisitRange, count, 64, &data);
+        EXPECT(IsVisitedOnce(data, count));
+
+        // Without workers the whole range may run as one call
+        EXPECT(data.batches <= (count + 63) / 64);
+        EXPECT(count == 0 || data.batches > 0);
+    }
+
+    ShutdownJobs();
+}
+
+TEST(JobsRunBackToBack) {
+    static JobsTestData data;
+    InitJobs();
+
+    // A worker waking late for one job must not take batches of the next
+    bool all_visited = true;
+    for (int run = 0; run < JOBS_TEST_RUNS; run++) {
+        ResetJobsTestData(data);
+        RunParallel(VisitRange, JOBS_TEST_COUNT, 16, &data);
+        all_visited &= IsVisitedOnce(data, JOBS_TEST_COUNT);
+    }
+    EXPECT(all_visited);
+
+    ShutdownJobs();
+}
+
+TEST(JobsAcceptTwoSubmittingThreads) {
+    static JobsTestData first;
+    static JobsTestData second;
+    InitJobs();
+
+    // The simulation and render threads both submit, the pool serialises them
+    bool first_visited = true;
+    bool second_visited = true;
+    std::thread other([&second_visited] {
+        for (int run = 0; run < JOBS_TEST_RUNS; run++) {
+            ResetJobsTestData(second);
+            RunParallel(VisitRange, JOBS_TEST_COUNT, 32, &second);
+            second_visited &= IsVisitedOnce(second, JOBS_TEST_COUNT);
+        }
+    });
+
+    for (int run = 0; run < JOBS_TEST_RUNS; run++) {
+        ResetJobsTestData(first);
+        RunParallel(VisitRange, JOBS_TEST_COUNT, 32, &first);
+        first_visited &= IsVisitedOnce(first, JOBS_TEST_COUNT);
+    }
+
+    other.join();
+    EXPECT(first_visited);
+    EXPECT(second_visited);
+
+    ShutdownJobs();
+}
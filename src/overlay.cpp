@@ -0,0 +1,193 @@
+//
+//  Battle TowerZ - Copyright(c) 2025 NoZ Games, LLC
+//
+
+constexpr int MAX_OVERLAY_ICON_VERTICES = 64;
+constexpr int MAX_OVERLAY_ICON_INDICES = 192;
+constexpr int MAX_OVERLAY_BAR_VERTICES = 8;
+constexpr int MAX_OVERLAY_BAR_INDICES = 12;
+constexpr Vec2 OVERLAY_ICON_POSITION = {0.0f, 1.1f};
+constexpr float OVERLAY_ICON_SCALE = 0.35f;
+constexpr Vec2 OVERLAY_BAR_POSITION = {0.0f, 1.45f};
+constexpr Vec2 OVERLAY_BAR_SIZE = {0.5f, 0.06f};
+constexpr float OVERLAY_BAR_BORDER = 0.015f;
+
+// Triangles of a MESH_ICON_STATE_* mesh, already placed and scaled above the unit
+struct OverlayIcon {
+    Vec2 positions[MAX_OVERLAY_ICON_VERTICES];
+    Vec2 uvs[MAX_OVERLAY_ICON_VERTICES];
+    int vertex_count;
+    u16 indices[MAX_OVERLAY_ICON_INDICES];
+    int index_count;
+};
+
+// Health bar of one unit in unit space, only rebuilt when the health of the unit changes.  The
+// icon of the state is shared and mirrored with the unit, the bar is not.
+struct OverlayUnit {
+    u32 generation;
+    float health;
+    Vec2 positions[MAX_OVERLAY_BAR_VERTICES];
+    Vec2 uvs[MAX_OVERLAY_BAR_VERTICES];
+    u16 indices[MAX_OVERLAY_BAR_INDICES];
+    int vertex_count;
+    int index_count;
+};
+
+struct OverlaySystem {
+    OverlayIcon icons[UNIT_STATE_COUNT];
+    OverlayUnit units[MAX_ENTITIES];
+    Mesh* mesh;
+};
+
+static OverlaySystem g_overlay = {};
+
+// The icon meshes are already triangulated, an icon too large for the overlay is left empty
+static void CopyOverlayIcon(OverlayIcon& icon, Mesh* mesh) {
+    icon.vertex_count = 0;
+    icon.index_count = 0;
+    if (!mesh)
+        return;
+
+    int vertex_count = GetVertexCount(mesh);
+    int index_count = GetIndexCount(mesh);
+    if (vertex_count > MAX_OVERLAY_ICON_VERTICES || index_count > MAX_OVERLAY_ICON_INDICES)
+        return;
+
+    const MeshVertex* vertices = GetVertices(mesh);
+    const u16* indices = GetIndices(mesh);
+    for (int i = 0; i < vertex_count; i++) {
+        icon.positions[i] = OVERLAY_ICON_POSITION + vertices[i].position * OVERLAY_ICON_SCALE;
+        icon.uvs[i] = vertices[i].uv0;
+    }
+    for (int i = 0; i < index_count; i++)
+        icon.indices[i] = indices[i];
+
+    icon.vertex_count = vertex_count;
+    icon.index_count = index_count;
+}
+
+static void AddOverlayQuad(OverlayUnit& overlay, const Vec2& min, const Vec2& max, const Vec2& uv) {
+    u16 base = static_cast<u16>(overlay.vertex_count);
+    overlay.positions[base + 0] = {min.x, min.y};
+    overlay.positions[base + 1] = {max.x, min.y};
+    overlay.positions[base + 2] = {max.x, max.y};
+    overlay.positions[base + 3] = {min.x, max.y};
+    for (int i = 0; i < 4; i++)
+        overlay.uvs[base + i] = uv;
+    overlay.vertex_count += 4;
+
+    u16 quad[] = { 0, 1, 2, 0, 2, 3 };
+    for (u16 index : quad)
+        overlay.indices[overlay.index_count++] = base + index;
+}
+
+static void BuildOverlayUnit(OverlayUnit& overlay, UnitEntity* u) {
+    overlay.generation = u->generation;
+    overlay.health = u->health;
+    overlay.vertex_count = 0;
+    overlay.index_count = 0;
+
+    float health = u->max_health > 0.0f ? Clamp(u->health / u->max_health, 0.0f, 1.0f) : 0.0f;
+    Vec2 half_size = OVERLAY_BAR_SIZE * 0.5f;
+    Vec2 border = {OVERLAY_BAR_BORDER, OVERLAY_BAR_BORDER};
+    Vec2 bar_min = OVERLAY_BAR_POSITION - half_size;
+    Vec2 bar_max = OVERLAY_BAR_POSITION + half_size;
+    AddOverlayQuad(overlay, bar_min - border, bar_max + border, ColorUV(0,0));
+    AddOverlayQuad(overlay, bar_min, Vec2{bar_min.x + OVERLAY_BAR_SIZE.x * health, bar_max.y}, ColorUV(6,1) + GetTeamColorOffset(u->team));
+}
+
+// Every visible unit's state icon and health bar go into one mesh that is drawn with a single call
+void DrawOverlay() {
+    if (!g_game.show_overlay)
+        return;
+
+    int count;
+    Entity** entities = GetVisibleEntities(CULL_PASS_MAIN, &count);
+
+    int vertex_count = 0;
+    int index_count = 0;
+    for (int i = 0; i < count; i++) {
+        if (entities[i]->type != ENTITY_TYPE_UNIT)
+            continue;
+
+        UnitEntity* u = static_cast<UnitEntity*>(entities[i]);
+        if (u->state == UNIT_STATE_DEAD)
+            continue;
+
+        OverlayUnit& overlay = g_overlay.units[GetRenderIndex(u)];
+        if (overlay.generation != u->generation || overlay.health != u->health) {
+            BuildOverlayUnit(overlay, u);
+            g_game.stats.overlay_rebuilds++;
+        }
+
+        vertex_count += g_overlay.icons[u->state].vertex_count + overlay.vertex_count;
+        index_count += g_overlay.icons[u->state].index_count + overlay.index_count;
+    }
+
+    if (g_overlay.mesh) {
+        Free(g_overlay.mesh);
+        g_overlay.mesh = nullptr;
+    }
+
+    if (vertex_count == 0)
+        return;
+
+    PushScratch();
+    MeshBuilder* builder = CreateMeshBuilder(ALLOCATOR_SCRATCH, vertex_count, index_count);
+    int base = 0;
+    for (int i = 0; i < count; i++) {
+        if (entities[i]->type != ENTITY_TYPE_UNIT)
+            continue;
+
+        UnitEntity* u = static_cast<UnitEntity*>(entities[i]);
+        if (u->state == UNIT_STATE_DEAD)
+            continue;
+
+        const OverlayIcon& icon = g_overlay.icons[u->state];
+        const OverlayUnit& overlay = g_overlay.units[GetRenderIndex(u)];
+        Vec2 position = WorldToScreen(u->position);
+        for (int v = 0; v < icon.vertex_count; v++)
+            AddVertex(builder, position + Vec2{icon.positions[v].x * u->scale.x, icon.positions[v].y * u->scale.y}, icon.uvs[v]);
+        for (int t = 0; t < icon.index_count; t += 3)
+            AddTriangle(
+                builder,
+                static_cast<u16>(base + icon.indices[t + 0]),
+                static_cast<u16>(base + icon.indices[t + 1]),
+                static_cast<u16>(base + icon.indices[t + 2]));
+        base += icon.vertex_count;
+
+        for (int v = 0; v < overlay.vertex_count; v++)
+            AddVertex(builder, position + overlay.positions[v], overlay.uvs[v]);
+        for (int t = 0; t < overlay.index_count; t += 3)
+            AddTriangle(
+                builder,
+                static_cast<u16>(base + overlay.indices[t + 0]),
+                static_cast<u16>(base + overlay.indices[t + 1]),
+                static_cast<u16>(base + overlay.indices[t + 2]));
+        base += overlay.vertex_count;
+
+        g_game.stats.overlay_units++;
+    }
+
+    g_overlay.mesh = CreateMesh(ALLOCATOR_DEFAULT, builder, NAME_NONE, true);
+    PopScratch();
+
+    BindColor(COLOR_WHITE);
+    BindDepth(GetApplicationTraits()->renderer.max_depth * 0.9f);
+    BindMaterial(g_game.material);
+    DrawMesh(g_overlay.mesh, Translate(VEC2_ZERO));
+    BindDepth(0.0f);
+}
+
+// Runs with the other asset tables so a hotloaded icon mesh shows up on the next frame
+void InitOverlay() {
+    CopyOverlayIcon(g_overlay.icons[UNIT_STATE_MOVE], MESH_ICON_STATE_MOVE);
+    CopyOverlayIcon(g_overlay.icons[UNIT_STATE_ATTACK], MESH_ICON_STATE_ATTACK);
+    CopyOverlayIcon(g_overlay.icons[UNIT_STATE_RELOAD], MESH_ICON_STATE_RELOAD);
+}
+
+void ShutdownOverlay() {
+    if (g_overlay.mesh)
+        Free(g_overlay.mesh);
+    g_overlay = {};
+}
@@ -4,6 +4,7 @@
 
 constexpr float ARROW_HIT_DISTANCE = 0.1f;
 constexpr float ARROW_DAMAGE = 1.0f;
+constexpr float ARROW_BLOOD_SCALE = 0.4f;
 
 inline ProjectileEntity* CastArrow(Entity* e) {
     assert(e && e->type == ENTITY_TYPE_PROJECTILE);
@@ -15,11 +16,14 @@ inline ProjectileEntity* CastArrow(Entity* e) {
 static void RenderArrow(Entity* e, const Mat3& transform) {
     ProjectileEntity* p = CastArrow(e);
 
-    BindDepth(1.0f);
-    BindMaterial(g_game.material);
-    BindColor(COLOR_WHITE, GetTeamColorOffset(p->team));
-    DrawMesh(MESH_PROJECTILE_ARROW, transform * Scale(1.0f + (e->position.y / 10.0f)));
-    BindDepth(0.0f);
+    AddDraw(
+        DRAW_PASS_MAIN,
+        g_game.material,
+        MESH_PROJECTILE_ARROW,
+        transform * Scale(1.0f + (e->position.y / 10.0f)),
+        1.0f,
+        COLOR_WHITE,
+        GetTeamColorOffset(p->team));
 }
 
 static void UpdateArrow(Entity* e) {
@@ -39,16 +43,21 @@ static void UpdateArrow(Entity* e) {
     //     return;
     // }
 
+    // A miss leaves the arrow stuck in the ground as a decal instead of an entity
     if (p->position.y <= 0.0f) {
+        AddGroundDecal(DECAL_TYPE_ARROW, XZ(p->position), p->rotation, p->scale.x, p->team);
         Free(p);
         return;
     }
 
     UnitEntity* target = FindClosestEnemy(p->team, p->position, F32_MAX);
     if (target && p->position.y < target->info->height && DistanceSqr(target, p->position) <= Sqr(ARROW_HIT_DISTANCE + target->size)) {
+        // Damage can free the target, everything that reads it goes first
+        AddGroundDecal(DECAL_TYPE_BLOOD, XZ(target->position), p->rotation, ARROW_BLOOD_SCALE, target->team);
+        AttachToStick(target, &MESH_PROJECTILE_ARROW, WorldToScreen(p->position), Normalize(WorldToScreen(p->velocity)), p->team);
         Damage(target, DAMAGE_TYPE_PHYSICAL, ARROW_DAMAGE);
-        Play(SOUND_REVOLVER_FIRE_A, 1.0f, 1.0f);
-        Play(VFX_ARROW_HIT, WorldToScreen(p->position));
+        TriggerSound(SOUND_REVOLVER_FIRE_A, WorldToScreen(p->position));
+        TriggerVfx(VFX_ARROW_HIT, WorldToScreen(p->position));
         Free(p);
         return;
     }
@@ -10,11 +10,7 @@ inline ProjectileEntity* CastBullet(Entity* e) {
 }
 
 static void DrawBullet(Entity*, const Mat3& transform) {
-    BindDepth(1.0f);
-    BindMaterial(g_game.material);
-    BindColor(COLOR_WHITE);
-    DrawMesh(MESH_BULLET, transform);
-    BindDepth(0.0f);
+    AddDraw(DRAW_PASS_MAIN, g_game.material, MESH_BULLET, transform, 1.0f, COLOR_WHITE);
 }
 
 static void UpdateBullet(Entity* e) {
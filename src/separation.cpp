@@ -0,0 +1,221 @@
+//
+//  Battle TowerZ - Copyright(c) 2025 NoZ Games, LLC
+//
+
+constexpr int SEPARATION_ITERATIONS = 4;
+constexpr int SEPARATION_BATCH_SIZE = 64;
+
+// Cells have to be at least as wide as the largest pair of touching discs so every contact is
+// found in the 3x3 cells around a unit
+constexpr float SEPARATION_CELL_SIZE = 2.0f;
+constexpr int SEPARATION_CELLS_X = static_cast<int>(WORLD_TILES_X * WORLD_TILE_SIZE / SEPARATION_CELL_SIZE);
+constexpr int SEPARATION_CELLS_Y = static_cast<int>(WORLD_TILES_Y * WORLD_TILE_SIZE / SEPARATION_CELL_SIZE);
+constexpr int SEPARATION_CELL_COUNT = SEPARATION_CELLS_X * SEPARATION_CELLS_Y;
+
+// Corrections of a unit are averaged over its contacts and then over relaxed, a plain average
+// converges too slowly in a dense crowd
+constexpr float SEPARATION_RELAXATION = 1.5f;
+
+// Units are binned by cell with a counting sort every tick, which keeps them in pool order within
+// a cell.  Each iteration every cell computes the corrections of its own units from the positions
+// of the previous iteration, so the cells can be solved on any thread in any order and the result
+// is always the same.
+struct SeparationSystem {
+    UnitEntity* units[MAX_UNITS];
+    int unit_cells[MAX_UNITS];
+    int unit_count;
+    int cell_start[SEPARATION_CELL_COUNT + 1];
+    int cell_fill[SEPARATION_CELL_COUNT];
+    int sorted[MAX_UNITS];
+    float x[MAX_UNITS];
+    float y[MAX_UNITS];
+    float radius[MAX_UNITS];
+    float next_x[MAX_UNITS];
+    float next_y[MAX_UNITS];
+    int contacts[MAX_UNITS];
+    float penetration[MAX_UNITS];
+};
+
+static SeparationSystem g_separation = {};
+
+static int GetSeparationCell(float value, float min, int count) {
+    return Clamp(static_cast<int>(floorf((value - min) / SEPARATION_CELL_SIZE)), 0, count - 1);
+}
+
+static int AddSeparationDisc(const Vec2& position, float radius) {
+    int index = g_separation.unit_count++;
+    g_separation.x[index] = position.x;
+    g_separation.y[index] = position.y;
+    g_separation.radius[index] = radius;
+
+    int cell_x = GetSeparationCell(position.x, WORLD_TILES_MIN.x, SEPARATION_CELLS_X);
+    int cell_y = GetSeparationCell(position.y, WORLD_TILES_MIN.y, SEPARATION_CELLS_Y);
+    g_separation.unit_cells[index] = cell_y * SEPARATION_CELLS_X + cell_x;
+    return index;
+}
+
+static bool CollectSeparationUnit(u32, void* item, void*) {
+    Entity* e = static_cast<Entity*>(item);
+    if (e->type != ENTITY_TYPE_UNIT)
+        return true;
+
+    // Static units are pushed against through the obstacle field instead
+    UnitEntity* u = static_cast<UnitEntity*>(e);
+    if (u->is_static || u->state == UNIT_STATE_DEAD || u->health <= 0.0f || u->size <= 0.0f)
+        return true;
+
+    if (g_separation.unit_count >= MAX_UNITS)
+        return false;
+
+    g_separation.units[AddSeparationDisc(XZ(u->position), u->size)] = u;
+    return true;
+}
+
+static void BinSeparationUnits() {
+    for (int cell = 0; cell <= SEPARATION_CELL_COUNT; cell++)
+        g_separation.cell_start[cell] = 0;
+
+    for (int i = 0; i < g_separation.unit_count; i++)
+        g_separation.cell_start[g_separation.unit_cells[i] + 1]++;
+
+    for (int cell = 0; cell < SEPARATION_CELL_COUNT; cell++) {
+        g_separation.cell_start[cell + 1] += g_separation.cell_start[cell];
+        g_separation.cell_fill[cell] = g_separation.cell_start[cell];
+    }
+
+    for (int i = 0; i < g_separation.unit_count; i++)
+        g_separation.sorted[g_separation.cell_fill[g_separation.unit_cells[i]]++] = i;
+}
+
+// Each overlapping pair is pushed apart along the line between the centers, half the penetration
+// per unit.  Static obstacles do not move so a unit takes their whole penetration.
+static void SolveSeparationCells(int start, int end, void*) {
+    const float* x = g_separation.x;
+    const float* y = g_separation.y;
+    const float* radius = g_separation.radius;
+
+    for (int cell = start; cell < end; cell++) {
+        int cell_x = cell % SEPARATION_CELLS_X;
+        int cell_y = cell / SEPARATION_CELLS_X;
+        int min_x = Max(cell_x - 1, 0);
+        int max_x = Min(cell_x + 1, SEPARATION_CELLS_X - 1);
+        int min_y = Max(cell_y - 1, 0);
+        int max_y = Min(cell_y + 1, SEPARATION_CELLS_Y - 1);
+
+        for (int s = g_separation.cell_start[cell]; s < g_separation.cell_start[cell + 1]; s++) {
+            int i = g_separation.sorted[s];
+            float dx = 0.0f;
+            float dy = 0.0f;
+            int contacts = 0;
+            float penetration = 0.0f;
+
+            for (int ny = min_y; ny <= max_y; ny++) {
+                for (int nx = min_x; nx <= max_x; nx++) {
+                    int neighbor_cell = ny * SEPARATION_CELLS_X + nx;
+                    for (int ns = g_separation.cell_start[neighbor_cell]; ns < g_separation.cell_start[neighbor_cell + 1]; ns++) {
+                        int j = g_separation.sorted[ns];
+                        if (j == i)
+                            continue;
+
+                        float ox = x[i] - x[j];
+                        float oy = y[i] - y[j];
+                        float min_distance = radius[i] + radius[j];
+                        float distance_sqr = ox * ox + oy * oy;
+                        if (distance_sqr >= min_distance * min_distance)
+                            continue;
+
+                        // Units standing exactly on top of each other are split by pool order
+                        float distance = sqrtf(distance_sqr);
+                        float depth = min_distance - distance;
+                        float nx_dir = distance > F32_EPSILON ? ox / distance : (i < j ? -1.0f : 1.0f);
+                        float ny_dir = distance > F32_EPSILON ? oy / distance : 0.0f;
+                        dx += nx_dir * depth * 0.5f;
+                        dy += ny_dir * depth * 0.5f;
+                        penetration += depth;
+                        contacts++;
+                    }
+                }
+            }
+
+            Vec2 position = {x[i], y[i]};
+            float obstacle_depth = radius[i] - GetObstacleDistance(position);
+            if (obstacle_depth > 0.0f) {
+                Vec2 normal = GetObstacleNormal(position);
+                dx += normal.x * obstacle_depth;
+                dy += normal.y * obstacle_depth;
+                penetration += obstacle_depth;
+                contacts++;
+            }
+
+            float scale = contacts > 0 ? SEPARATION_RELAXATION / static_cast<float>(contacts) : 0.0f;
+            g_separation.next_x[i] = x[i] + dx * scale;
+            g_separation.next_y[i] = y[i] + dy * scale;
+            g_separation.contacts[i] = contacts;
+            g_separation.penetration[i] = penetration;
+        }
+    }
+}
+
+// The residual penetration is measured by one more pass over the final positions, whose
+// corrections are dropped.  Compare it against the first pass to tune SEPARATION_ITERATIONS.
+static void SolveSeparation() {
+    BinSeparationUnits();
+
+    for (int iteration = 0; iteration <= SEPARATION_ITERATIONS; iteration++) {
+        RunParallel(SolveSeparationCells, SEPARATION_CELL_COUNT, SEPARATION_BATCH_SIZE, nullptr);
+
+        // Summed in unit order so the metric does not depend on how the cells were split
+        float penetration = 0.0f;
+        int contacts = 0;
+        for (int i = 0; i < g_separation.unit_count; i++) {
+            penetration += g_separation.penetration[i];
+            contacts += g_separation.contacts[i];
+        }
+
+        if (iteration == 0) {
+            g_game.stats.separation_contacts = contacts;
+            g_game.stats.separation_penetration = penetration;
+        }
+
+        g_game.stats.separation_residual = penetration;
+        if (contacts == 0 || iteration == SEPARATION_ITERATIONS)
+            break;
+
+        for (int i = 0; i < g_separation.unit_count; i++) {
+            g_separation.x[i] = g_separation.next_x[i];
+            g_separation.y[i] = g_separation.next_y[i];
+        }
+    }
+}
+
+// Pushes the overlapping discs apart in place, the same solve the units get every tick
+void SeparateDiscs(Vec2* positions, const float* radii, int count) {
+    assert(count <= MAX_UNITS);
+
+    g_separation.unit_count = 0;
+    for (int i = 0; i < count; i++)
+        AddSeparationDisc(positions[i], radii[i]);
+
+    if (count == 0)
+        return;
+
+    SolveSeparation();
+
+    for (int i = 0; i < count; i++)
+        positions[i] = Vec2{g_separation.x[i], g_separation.y[i]};
+}
+
+// Runs after the units moved this tick and pushes overlapping unit discs apart
+void UpdateSeparation() {
+    g_separation.unit_count = 0;
+    Enumerate(g_game.entity_allocator, CollectSeparationUnit);
+    if (g_separation.unit_count == 0)
+        return;
+
+    SolveSeparation();
+
+    for (int i = 0; i < g_separation.unit_count; i++) {
+        UnitEntity* u = g_separation.units[i];
+        u->position += XZ(Vec2{g_separation.x[i], g_separation.y[i]} - XZ(u->position));
+    }
+}
@@ -0,0 +1,90 @@
+//
+//  Battle TowerZ - Copyright(c) 2025 NoZ Games, LLC
+//
+
+#include "test.h"
+
+constexpr int SEPARATION_TEST_CROWD = 16;
+constexpr float SEPARATION_TEST_RADIUS = 0.5f;
+constexpr float SEPARATION_TEST_TOLERANCE = 0.0001f;
+
+static float g_separation_test_radii[SEPARATION_TEST_CROWD] = {};
+
+static void BeginSeparationTest() {
+    ClearStaticObstacles();
+    for (float& radius : g_separation_test_radii)
+        radius = SEPARATION_TEST_RADIUS;
+}
+
+// Sum of the overlap of every pair of discs
+static float GetTotalOverlap(const Vec2* positions, int count) {
+    float overlap = 0.0f;
+    for (int i = 0; i < count; i++)
+        for (int j = i + 1; j < count; j++)
+            overlap += Max(0.0f, g_separation_test_radii[i] + g_separation_test_radii[j] - Length(positions[i] - positions[j]));
+    return overlap;
+}
+
+TEST(SeparationPushesOverlappingPairApart) {
+    BeginSeparationTest();
+    Vec2 positions[] = { {0.0f, 0.0f}, {0.6f, 0.0f} };
+    SeparateDiscs(positions, g_separation_test_radii, 2);
+
+    EXPECT(Length(positions[1] - positions[0]) >= SEPARATION_TEST_RADIUS * 2.0f - SEPARATION_TEST_TOLERANCE);
+    EXPECT_NEAR(positions[0].x + positions[1].x, 0.6f, SEPARATION_TEST_TOLERANCE);
+    EXPECT_NEAR(positions[0].y, 0.0f, SEPARATION_TEST_TOLERANCE);
+    EXPECT_NEAR(positions[1].y, 0.0f, SEPARATION_TEST_TOLERANCE);
+    EXPECT_NEAR(g_game.stats.separation_penetration, 0.8f, SEPARATION_TEST_TOLERANCE);
+    EXPECT_NEAR(g_game.stats.separation_residual, 0.0f, SEPARATION_TEST_TOLERANCE);
+}
+
+TEST(SeparationLeavesSeparateDiscsAlone) {
+    BeginSeparationTest();
+    const Vec2 start[] = { {0.0f, 0.0f}, {1.5f, 0.0f}, {0.0f, 1.0f} };
+    Vec2 positions[] = { start[0], start[1], start[2] };
+    SeparateDiscs(positions, g_separation_test_radii, 3);
+
+    for (int i = 0; i < 3; i++)
+        EXPECT(positions[i].x == start[i].x && positions[i].y == start[i].y);
+}
+
+// Discs on the same spot have no direction between them and are split by their order
+TEST(SeparationSplitsCoincidentDiscs) {
+    BeginSeparationTest();
+    Vec2 positions[] = { {2.0f, 2.0f}, {2.0f, 2.0f} };
+    SeparateDiscs(positions, g_separation_test_radii, 2);
+
+    EXPECT(positions[0].x < positions[1].x);
+    EXPECT(Length(positions[1] - positions[0]) > 0.0f);
+}
+
+// A packed crowd spread over several cells ends up with far less overlap than it started with
+TEST(SeparationRelaxesCrowd) {
+    BeginSeparationTest();
+    Vec2 positions[SEPARATION_TEST_CROWD];
+    for (int i = 0; i < SEPARATION_TEST_CROWD; i++)
+        positions[i] = Vec2{(i % 4) * 0.5f - 1.0f, (i / 4) * 0.5f - 1.0f};
+
+    float before = GetTotalOverlap(positions, SEPARATION_TEST_CROWD);
+    SeparateDiscs(positions, g_separation_test_radii, SEPARATION_TEST_CROWD);
+    float after = GetTotalOverlap(positions, SEPARATION_TEST_CROWD);
+
+    EXPECT(before > 0.0f);
+    EXPECT(after < before * 0.5f);
+
+    // The residual is measured on the positions handed back, every pair counted from both sides
+    EXPECT_NEAR(g_game.stats.separation_residual, after * 2.0f, 0.001f);
+}
+
+TEST(SeparationPushesOutOfObstacles) {
+    BeginSeparationTest();
+    AddStaticObstacle(VEC2_ZERO, 2.0f, EntityHandle{ 1, 1 });
+    BuildObstacleField();
+
+    Vec2 positions[] = { {2.2f, 0.0f} };
+    SeparateDiscs(positions, g_separation_test_radii, 1);
+    ClearStaticObstacles();
+
+    EXPECT(positions[0].x >= 2.0f + SEPARATION_TEST_RADIUS - 0.1f);
+    EXPECT_NEAR(positions[0].y, 0.0f, 0.1f);
+}
@@ -0,0 +1,246 @@
+//
+//  Battle TowerZ - Copyright(c) 2025 NoZ Games, LLC
+//
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+constexpr int SNAPSHOT_COUNT = 3;
+constexpr int MAX_SNAPSHOT_TRIGGERS = 1024;
+
+enum SnapshotTriggerType {
+    SNAPSHOT_TRIGGER_VFX,
+    SNAPSHOT_TRIGGER_SOUND
+};
+
+// Side effect raised by the simulation that has to be played on the main thread
+struct SnapshotTrigger {
+    SnapshotTriggerType type;
+    Vfx* vfx;
+    VfxPriority priority;
+    Sound* sound;
+    Vec2 position;
+    float volume;
+    float pitch;
+};
+
+// Immutable copy of everything the renderer reads from the entities after a tick.  Entities are
+// copied whole, indexed by their pool slot, with their bones copied into the animator of the copy
+// so nothing points back into state the next tick is changing.
+struct RenderSnapshot {
+    FatEntity* entities;
+    Entity* list[MAX_ENTITIES];
+    int entity_count;
+    SnapshotTrigger triggers[MAX_SNAPSHOT_TRIGGERS];
+    int trigger_count;
+    u32 tick;
+};
+
+// The battle is ticked on its own thread while the main thread draws the snapshot published by
+// the previous tick.  Snapshots are triple buffered: the simulation owns the write snapshot, the
+// renderer owns the read snapshot and the ready snapshot is swapped between them under the lock.
+struct SimulationSystem {
+    RenderSnapshot snapshots[SNAPSHOT_COUNT];
+    int write_index;
+    int ready_index;
+    int read_index;
+    bool ready;
+    u32 tick;
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    bool running;
+    bool quit;
+};
+
+static SimulationSystem g_simulation = {};
+
+static RenderSnapshot& GetWriteSnapshot() {
+    return g_simulation.snapshots[g_simulation.write_index];
+}
+
+static SnapshotTrigger* AddTrigger(SnapshotTriggerType type) {
+    RenderSnapshot& snapshot = GetWriteSnapshot();
+    if (snapshot.trigger_count >= MAX_SNAPSHOT_TRIGGERS)
+        return nullptr;
+
+    SnapshotTrigger* trigger = &snapshot.triggers[snapshot.trigger_count++];
+    *trigger = {};
+    trigger->type = type;
+    return trigger;
+}
+
+void TriggerVfx(Vfx* vfx, const Vec2& position, VfxPriority priority) {
+    SnapshotTrigger* trigger = AddTrigger(SNAPSHOT_TRIGGER_VFX);
+    if (!trigger)
+        return;
+
+    trigger->vfx = vfx;
+    trigger->position = position;
+    trigger->priority = priority;
+}
+
+void TriggerSound(Sound* sound, const Vec2& position, float volume, float pitch) {
+    SnapshotTrigger* trigger = AddTrigger(SNAPSHOT_TRIGGER_SOUND);
+    if (!trigger)
+        return;
+
+    trigger->sound = sound;
+    trigger->position = position;
+    trigger->volume = volume;
+    trigger->pitch = pitch;
+}
+
+static bool CopyEntity(u32, void* item, void* user_data) {
+    Entity* e = static_cast<Entity*>(item);
+    RenderSnapshot& snapshot = *static_cast<RenderSnapshot*>(user_data);
+
+    u32 index = GetIndex(g_game.entity_allocator, e);
+    FatEntity* copy = &snapshot.entities[index];
+    memcpy(copy, e, sizeof(FatEntity));
+
+    // Bones always live in the animator, the copy points at its own
+    if (e->bones)
+        copy->entity.bones = copy->entity.animator.bones;
+
+    copy->entity.world_bones = nullptr;
+    copy->entity.shadow_bones = nullptr;
+    snapshot.list[snapshot.entity_count++] = &copy->entity;
+    return true;
+}
+
+static void PublishSnapshot() {
+    RenderSnapshot& snapshot = GetWriteSnapshot();
+    snapshot.entity_count = 0;
+    snapshot.tick = ++g_simulation.tick;
+    Enumerate(g_game.entity_allocator, CopyEntity, &snapshot);
+
+    std::lock_guard<std::mutex> lock(g_simulation.mutex);
+
+    // A snapshot the renderer never picked up still carries triggers that have to be played
+    RenderSnapshot& stale = g_simulation.snapshots[g_simulation.ready_index];
+    if (g_simulation.ready) {
+        int count = Min(stale.trigger_count, MAX_SNAPSHOT_TRIGGERS - snapshot.trigger_count);
+        for (int i = 0; i < count; i++)
+            snapshot.triggers[snapshot.trigger_count++] = stale.triggers[i];
+    }
+
+    int write_index = g_simulation.write_index;
+    g_simulation.write_index = g_simulation.ready_index;
+    g_simulation.ready_index = write_index;
+    g_simulation.ready = true;
+    GetWriteSnapshot().trigger_count = 0;
+}
+
+static void SimulationThread() {
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(g_simulation.mutex);
+            g_simulation.wake.wait(lock, [] { return g_simulation.quit || g_simulation.running; });
+            if (g_simulation.quit)
+                return;
+        }
+
+        SimulateBattle();
+        PublishSnapshot();
+
+        std::lock_guard<std::mutex> lock(g_simulation.mutex);
+        g_simulation.running = false;
+        g_simulation.done.notify_all();
+    }
+}
+
+// Runs one tick on the simulation thread.  Game state may only be touched by the main thread
+// again after WaitForSimulation.
+void StartSimulation() {
+    {
+        std::lock_guard<std::mutex> lock(g_simulation.mutex);
+        assert(!g_simulation.running);
+        g_simulation.running = true;
+    }
+    g_simulation.wake.notify_all();
+}
+
+void WaitForSimulation() {
+    std::unique_lock<std::mutex> lock(g_simulation.mutex);
+    g_simulation.done.wait(lock, [] { return !g_simulation.running; });
+}
+
+// Takes the newest published snapshot for drawing and plays the triggers raised while it was built
+void AcquireRenderSnapshot() {
+    {
+        std::lock_guard<std::mutex> lock(g_simulation.mutex);
+        if (!g_simulation.ready)
+            return;
+
+        int read_index = g_simulation.read_index;
+        g_simulation.read_index = g_simulation.ready_index;
+        g_simulation.ready_index = read_index;
+        g_simulation.ready = false;
+    }
+
+    RenderSnapshot& snapshot = g_simulation.snapshots[g_simulation.read_index];
+    for (int i = 0; i < snapshot.trigger_count; i++) {
+        const SnapshotTrigger& trigger = snapshot.triggers[i];
+        if (trigger.type == SNAPSHOT_TRIGGER_VFX)
+            PlayVfx(trigger.vfx, trigger.position, trigger.priority);
+        else
+            PlaySoundAt(trigger.sound, trigger.position, trigger.volume, trigger.pitch);
+    }
+
+    snapshot.trigger_count = 0;
+}
+
+Entity** GetRenderEntities(int* count) {
+    RenderSnapshot& snapshot = g_simulation.snapshots[g_simulation.read_index];
+    *count = snapshot.entity_count;
+    return snapshot.list;
+}
+
+int GetRenderIndex(Entity* entity) {
+    RenderSnapshot& snapshot = g_simulation.snapshots[g_simulation.read_index];
+    return static_cast<int>(reinterpret_cast<FatEntity*>(entity) - snapshot.entities);
+}
+
+// Snapshots can reference meshes owned by the asset tables, so they are dropped when those are rebuilt
+void ClearRenderSnapshots() {
+    std::lock_guard<std::mutex> lock(g_simulation.mutex);
+    for (RenderSnapshot& snapshot : g_simulation.snapshots)
+        snapshot.entity_count = 0;
+}
+
+void InitSimulation() {
+    for (int i = 0; i < SNAPSHOT_COUNT; i++) {
+        RenderSnapshot& snapshot = g_simulation.snapshots[i];
+        snapshot.entities = static_cast<FatEntity*>(Alloc(ALLOCATOR_DEFAULT, sizeof(FatEntity) * MAX_ENTITIES));
+        snapshot.entity_count = 0;
+        snapshot.trigger_count = 0;
+    }
+
+    g_simulation.write_index = 0;
+    g_simulation.ready_index = 1;
+    g_simulation.read_index = 2;
+    g_simulation.ready = false;
+    g_simulation.running = false;
+    g_simulation.quit = false;
+    g_simulation.thread = std::thread(SimulationThread);
+}
+
+void ShutdownSimulation() {
+    WaitForSimulation();
+
+    {
+        std::lock_guard<std::mutex> lock(g_simulation.mutex);
+        g_simulation.quit = true;
+    }
+    g_simulation.wake.notify_all();
+    g_simulation.thread.join();
+
+    for (RenderSnapshot& snapshot : g_simulation.snapshots) {
+        Free(snapshot.entities);
+        snapshot.entities = nullptr;
+        snapshot.entity_count = 0;
+    }
+}
@@ -0,0 +1,113 @@
+//
+//  Battle TowerZ - Copyright(c) 2025 NoZ Games, LLC
+//
+
+constexpr int MAX_SKINNED_VERTICES = 65536;
+
+// Merging and palette packing for single mesh skinned figures.  Both are pure functions over plain
+// arrays so the import step and the per frame upload can be checked on the CPU without a device.
+
+// Appends every part to the merged buffers in the order given, which is also the draw order the
+// parts overlap in, and tags each vertex with the bone that positions the part.  When remap is
+// given the bone is replaced by its palette slot from PackBonePalette, a part whose bone has no
+// slot fails the merge instead of following some other bone.
+bool MergeSkinnedParts(
+    const SkinnedPart* parts,
+    int part_count,
+    const u8* remap,
+    SkinnedVertex* vertices,
+    int max_vertices,
+    int* vertex_count,
+    u16* indices,
+    int max_indices,
+    int* index_count) {
+    assert(parts);
+    assert(vertices && vertex_count);
+    assert(indices && index_count);
+
+    int total_vertices = 0;
+    int total_indices = 0;
+    for (int part_index = 0; part_index < part_count; part_index++) {
+        const SkinnedPart& part = parts[part_index];
+        assert(part.bone >= 0 && part.bone < MAX_SKINNED_BONES);
+        if (remap && remap[part.bone] == SKINNED_BONE_INVALID)
+            return false;
+
+        total_vertices += part.vertex_count;
+        total_indices += part.index_count;
+    }
+
+    if (total_vertices > max_vertices || total_vertices > MAX_SKINNED_VERTICES || total_indices > max_indices)
+        return false;
+
+    int base_vertex = 0;
+    int base_index = 0;
+    for (int part_index = 0; part_index < part_count; part_index++) {
+        const SkinnedPart& part = parts[part_index];
+        u8 bone = remap ? remap[part.bone] : static_cast<u8>(part.bone);
+
+        for (int i = 0; i < part.vertex_count; i++) {
+            SkinnedVertex& vertex = vertices[base_vertex + i];
+            vertex.position = part.positions[i];
+            vertex.uv = part.uvs[i];
+            vertex.bone = bone;
+        }
+
+        for (int i = 0; i < part.index_count; i++)
+            indices[base_index + i] = static_cast<u16>(base_vertex + part.indices[i]);
+
+        base_vertex += part.vertex_count;
+        base_index += part.index_count;
+    }
+
+    *vertex_count = total_vertices;
+    *index_count = total_indices;
+    return true;
+}
+
+// Packs the bones in the mask into consecutive palette slots of BONE_PALETTE_STRIDE floats: the x
+// and y axes in the first vec4 and the translation in the second, matching a std140 vec4 array.
+// Bones outside the mask get SKINNED_BONE_INVALID.  Returns the number of slots written.
+int PackBonePalette(const Mat3* bones, int bone_count, u32 bone_mask, float* palette, u8* remap) {
+    assert(bones && palette);
+    assert(bone_count <= MAX_SKINNED_BONES);
+
+    int slot_count = 0;
+    for (int bone_index = 0; bone_index < bone_count; bone_index++) {
+        if (!(bone_mask & BoneMask(bone_index))) {
+            if (remap)
+                remap[bone_index] = SKINNED_BONE_INVALID;
+            continue;
+        }
+
+        Vec2 origin = TransformPoint(bones[bone_index]);
+        Vec2 axis_x = TransformPoint(bones[bone_index], Vec2{1, 0}) - origin;
+        Vec2 axis_y = TransformPoint(bones[bone_index], Vec2{0, 1}) - origin;
+
+        float* slot = palette + slot_count * BONE_PALETTE_STRIDE;
+        slot[0] = axis_x.x;
+        slot[1] = axis_x.y;
+        slot[2] = axis_y.x;
+        slot[3] = axis_y.y;
+        slot[4] = origin.x;
+        slot[5] = origin.y;
+        slot[6] = 0.0f;
+        slot[7] = 0.0f;
+
+        if (remap)
+            remap[bone_index] = static_cast<u8>(slot_count);
+
+        slot_count++;
+    }
+
+    return slot_count;
+}
+
+// Reference for the vertex stage: the position a skinned vertex ends up at for a packed palette
+Vec2 SkinVertex(const SkinnedVertex& vertex, const float* palette) {
+    assert(vertex.bone != SKINNED_BONE_INVALID);
+    const float* slot = palette + vertex.bone * BONE_PALETTE_STRIDE;
+    return Vec2{
+        slot[0] * vertex.position.x + slot[2] * vertex.position.y + slot[4],
+        slot[1] * vertex.position.x + slot[3] * vertex.position.y + slot[5]};
+}
@@ -0,0 +1,92 @@
+//
+//  Battle TowerZ - Copyright(c) 2025 NoZ Games, LLC
+//
+
+#include "test.h"
+
+constexpr int SKINNING_TEST_BONES = 4;
+constexpr float SKINNING_TEST_TOLERANCE = 0.0001f;
+
+// Bones 1 and 3 are drawn, 0 and 2 are masked out
+constexpr u32 SKINNING_TEST_MASK = (1u << 1) | (1u << 3);
+
+static const Vec2 SKINNING_TEST_POSITIONS[] = { {0.0f, 0.0f}, {1.0f, 0.0f}, {0.0f, 1.0f} };
+static const Vec2 SKINNING_TEST_UVS[] = { {0.0f, 0.0f}, {0.5f, 0.0f}, {0.0f, 0.5f} };
+static const u16 SKINNING_TEST_INDICES[] = { 0, 1, 2 };
+
+struct SkinningTestData {
+    Mat3 bones[SKINNING_TEST_BONES];
+    float palette[SKINNING_TEST_BONES * BONE_PALETTE_STRIDE];
+    u8 remap[SKINNING_TEST_BONES];
+    SkinnedVertex vertices[16];
+    u16 indices[16];
+    int vertex_count;
+    int index_count;
+};
+
+static SkinningTestData g_skinning_test = {};
+
+static SkinnedPart GetTestPart(int bone) {
+    return { SKINNING_TEST_POSITIONS, SKINNING_TEST_UVS, 3, SKINNING_TEST_INDICES, 3, bone };
+}
+
+// Every bone rotated and moved differently so a vertex skinned by the wrong slot shows up
+static int PackTestPalette() {
+    SkinningTestData& data = g_skinning_test;
+    for (int i = 0; i < SKINNING_TEST_BONES; i++)
+        data.bones[i] = TRS(Vec2{static_cast<float>(i), 2.0f * i}, 30.0f * i, VEC2_ONE);
+
+    return PackBonePalette(data.bones, SKINNING_TEST_BONES, SKINNING_TEST_MASK, data.palette, data.remap);
+}
+
+static bool MergeTestParts(const SkinnedPart* parts, int part_count, const u8* remap, int max_vertices) {
+    SkinningTestData& data = g_skinning_test;
+    return MergeSkinnedParts(parts, part_count, remap, data.vertices, max_vertices, &data.vertex_count, data.indices, 16, &data.index_count);
+}
+
+TEST(SkinningPacksOnlyMaskedBones) {
+    EXPECT(PackTestPalette() == 2);
+
+    const u8* remap = g_skinning_test.remap;
+    EXPECT(remap[0] == SKINNED_BONE_INVALID);
+    EXPECT(remap[1] == 0);
+    EXPECT(remap[2] == SKINNED_BONE_INVALID);
+    EXPECT(remap[3] == 1);
+
+    const float* slot = g_skinning_test.palette + BONE_PALETTE_STRIDE;
+    EXPECT_NEAR(slot[4], 3.0f, SKINNING_TEST_TOLERANCE);
+    EXPECT_NEAR(slot[5], 6.0f, SKINNING_TEST_TOLERANCE);
+}
+
+// Parts keep their order, indices move with their part and every vertex lands where its own bone puts it
+TEST(SkinningMergesPartsOnTheirBones) {
+    PackTestPalette();
+    SkinnedPart parts[] = { GetTestPart(3), GetTestPart(1) };
+    EXPECT(MergeTestParts(parts, 2, g_skinning_test.remap, 16));
+
+    const SkinningTestData& data = g_skinning_test;
+    EXPECT(data.vertex_count == 6);
+    EXPECT(data.index_count == 6);
+    EXPECT(data.indices[3] == 3 && data.indices[5] == 5);
+    EXPECT(data.vertices[0].bone == 1 && data.vertices[3].bone == 0);
+
+    for (int i = 0; i < data.vertex_count; i++) {
+        Vec2 expected = TransformPoint(data.bones[parts[i / 3].bone], SKINNING_TEST_POSITIONS[i % 3]);
+        Vec2 skinned = SkinVertex(data.vertices[i], data.palette);
+        EXPECT_NEAR(skinned.x, expected.x, SKINNING_TEST_TOLERANCE);
+        EXPECT_NEAR(skinned.y, expected.y, SKINNING_TEST_TOLERANCE);
+    }
+}
+
+TEST(SkinningRejectsPartOnMaskedBone) {
+    PackTestPalette();
+    SkinnedPart parts[] = { GetTestPart(1), GetTestPart(2) };
+    EXPECT(!MergeTestParts(parts, 2, g_skinning_test.remap, 16));
+}
+
+TEST(SkinningRejectsOverflow) {
+    SkinnedPart parts[] = { GetTestPart(1), GetTestPart(3) };
+    EXPECT(!MergeTestParts(parts, 2, nullptr, 5));
+    EXPECT(MergeTestParts(parts, 2, nullptr, 6));
+    EXPECT(g_skinning_test.vertices[3].bone == 3);
+}
@@ -0,0 +1,30 @@
+//
+//  Battle TowerZ - Copyright(c) 2025 NoZ Games, LLC
+//
+
+#pragma once
+
+// Self registering test cases for the battletowerz_tests target.  Each *_test.cpp file sits next
+// to the code it covers, defines its cases with TEST and checks them with EXPECT.
+
+typedef void (*TestFunc)();
+
+struct TestCase {
+    const char* name;
+    TestFunc func;
+    TestCase* next;
+};
+
+extern bool AddTestCase(TestCase* test);
+extern void FailTest(const char* file, int line, const char* expression);
+
+#define TEST(name) \
+    static void name(); \
+    static TestCase name##_case = { #name, name, nullptr }; \
+    static const bool name##_added = AddTestCase(&name##_case); \
+    static void name()
+
+#define EXPECT(expression) \
+    do { if (!(expression)) FailTest(__FILE__, __LINE__, #expression); } while (0)
+
+#define EXPECT_NEAR(a, b, tolerance) EXPECT(Abs((a) - (b)) <= (tolerance))
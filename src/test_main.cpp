@@ -0,0 +1,34 @@
+//
+//  Battle TowerZ - Copyright(c) 2025 NoZ Games, LLC
+//
+
+#include <cstdio>
+#include "test.h"
+
+static TestCase* g_tests = nullptr;
+static int g_test_failures = 0;
+
+bool AddTestCase(TestCase* test) {
+    test->next = g_tests;
+    g_tests = test;
+    return true;
+}
+
+void FailTest(const char* file, int line, const char* expression) {
+    printf("%s(%d): failed: %s\n", file, line, expression);
+    g_test_failures++;
+}
+
+// Runs every registered case and exits with the number of failed checks
+int main(int, char**) {
+    int count = 0;
+    for (TestCase* test = g_tests; test; test = test->next) {
+        int failures = g_test_failures;
+        test->func();
+        printf("%s %s\n", g_test_failures == failures ? "passed" : "FAILED", test->name);
+        count++;
+    }
+
+    printf("%d tests, %d failed checks\n", count, g_test_failures);
+    return g_test_failures;
+}
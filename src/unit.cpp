@@ -5,6 +5,20 @@
 #include "rvo.h"
 
 constexpr float UNIT_MIN_SPEED = 1.0f;
+constexpr float UNIT_FLOW_FIELD_DISTANCE = 12.0f;
+
+// Units start sliding along a static obstacle once they are this close to its edge
+constexpr float UNIT_OBSTACLE_AVOID_DISTANCE = 1.5f;
+
+// How much farther away a target may be for each unit of enemy influence less around it
+constexpr float UNIT_TARGET_THREAT_WEIGHT = 0.25f;
+
+// Best scored targets kept per search, line of sight is only traced through these in score order
+constexpr int UNIT_TARGET_CANDIDATES = 4;
+
+// Neighbours within this distance are avoided, a unit on ring r of the index is at least r - 1 tiles away
+constexpr float UNIT_RVO_DISTANCE = 5.0f;
+constexpr int UNIT_RVO_RINGS = static_cast<int>(UNIT_RVO_DISTANCE / WORLD_TILE_SIZE) + 1;
 constexpr float UNIT_SHUFFLE_SPEED = 0.1f;
 constexpr float UNIT_SHUFFLE_SPEED_SQR = UNIT_SHUFFLE_SPEED * UNIT_SHUFFLE_SPEED;
 
@@ -58,6 +72,9 @@ void Damage(UnitEntity* u, DamageType damage_type, float amount) {
     u->health -= amount;
 
     if (u->health < 0.0f) {
+        if (u->is_static)
+            RemoveStaticObstacle(GetHandle(u));
+
         if (u->vtable.death) {
             u->vtable.death(u, damage_type);
         } else {
@@ -117,6 +134,9 @@ UnitEntity* CreateUnit(UnitType type, Team team, const EntityVtable& vtable, con
     u->desired_velocity = VEC3_ZERO;
     u->target = {};
     u->info = GetUnitInfo(type);
+    u->attachment_count = 0;
+    u->attachment_next = 0;
+    u->is_static = false;
     return u;
 }
 
@@ -125,12 +145,12 @@ static bool CollectRVOAgent(UnitEntity* u, void* user_data) {
     assert(user_data);
     CollectRVOAgentsArgs* args = static_cast<CollectRVOAgentsArgs*>(user_data);
 
+    // Static units are not in the index, they are avoided through the obstacle field instead
     if (u == args->unit || u->health <= 0.0f)
         return true;
 
-    // Only consider nearby units (within 5 units)
     float distance_sq = DistanceSqr(args->unit, u->position);
-    if (distance_sq > 25.0f)
+    if (distance_sq > Sqr(UNIT_RVO_DISTANCE))
         return true;
 
     if (args->count >= 64)
@@ -152,7 +172,9 @@ Vec3 ComputeRVOVelocityForUnit(UnitEntity* u, const Vec3& preferred_velocity, fl
         .agents = {},
         .count = 0
     };
-    EnumerateUnits(u->team, CollectRVOAgent, &args);
+    for (int ring = 0; ring <= UNIT_RVO_RINGS; ring++)
+        if (!EnumerateUnitsInRing(u->team, XZ(u->position), ring, CollectRVOAgent, &args))
+            break;
 
     RVOAgent agent = {
         .position = u->position,
@@ -169,21 +191,57 @@ void ApplyImpulse(UnitEntity* u, const Vec3& impulse) {
     u->velocity += impulse;
 }
 
+// Takes away the part of the velocity heading into a nearby static obstacle, more of it the closer
+// the unit is, so units slide around obstacles instead of stopping against them
+static Vec3 AvoidObstacles(UnitEntity* u, const Vec3& velocity) {
+    Vec2 position = XZ(u->position);
+    float distance = GetObstacleDistance(position) - u->size;
+    if (distance >= UNIT_OBSTACLE_AVOID_DISTANCE)
+        return velocity;
+
+    Vec2 normal = GetObstacleNormal(position);
+    Vec2 planar = XZ(velocity);
+    float into = Dot(planar, normal);
+    if (into >= 0.0f)
+        return velocity;
+
+    float weight = 1.0f - Max(distance, 0.0f) / UNIT_OBSTACLE_AVOID_DISTANCE;
+    return velocity - XZ(normal * (into * weight));
+}
+
+static void ResolveObstacles(UnitEntity* u) {
+    Vec2 position = XZ(u->position);
+    float penetration = u->size - GetObstacleDistance(position);
+    if (penetration > 0.0f)
+        u->position += XZ(GetObstacleNormal(position) * penetration);
+}
+
 static void UpdateVelocity(UnitEntity* u) {
     UnitEntity* target = GetUnit(u->target);
     if (target && DistanceSqr(target, u) > Sqr(u->info->range)) {
-        Vec3 desired_velocity = Direction(u, target) * u->info->speed;
+        // Far from the target the team's flow field leads toward the enemy instead
+        Vec3 direction = Direction(u, target);
+        if (DistanceSqr(target, u) > Sqr(UNIT_FLOW_FIELD_DISTANCE)) {
+            Vec2 flow = SampleFlowField(u->team, XZ(u->position));
+            if (LengthSqr(flow) > 0.0f)
+                direction = XZ(flow);
+        }
+
+        Vec3 desired_velocity = direction * u->info->speed;
         u->desired_velocity = ComputeRVOVelocityForUnit(u, desired_velocity, u->info->speed);
     } else {
         u->desired_velocity = ComputeRVOVelocityForUnit(u, VEC3_ZERO, u->info->speed);
     }
 
+    u->desired_velocity = AvoidObstacles(u, u->desired_velocity);
+
     float dt = GetGameFrameTime();
     u->velocity = u->desired_velocity;
     float speed = Clamp(Length(u->velocity), 0.0f, u->info->speed);
     speed = Max(UNIT_MIN_SPEED, speed);
     u->velocity = Normalize(u->velocity) * speed;
     u->position += u->velocity * dt;
+    ResolveObstacles(u);
 }
 
 static void UpdateMoveState(UnitEntity* u) {
@@ -231,7 +289,15 @@ static void UpdateIdleState(UnitEntity* u) {
 }
 
 static void UpdateDeadState(UnitEntity* u) {
-    UpdateStickRagdoll(u, GetGameFrameTime());
+    UpdateStickRagdoll(u);
+
+    // Once the body stops moving it is baked into the ground layer and the entity is released
+    if (!u->vtable.bake || !IsRagdollSettled(u))
+        return;
+
+    u->vtable.bake(u, GetEntityTransform(u));
+    DisableRagdoll(u);
+    Free(u);
 }
 
 static void UpdateReloadState(UnitEntity* u) {
@@ -301,12 +367,79 @@ void SetState(UnitEntity* u, UnitState new_state) {
         SetDeadState(u);
 }
 
+struct FindBestTargetArgs {
+    UnitEntity* unit;
+    UnitEntity* targets[UNIT_TARGET_CANDIDATES];
+    float target_scores[UNIT_TARGET_CANDIDATES];
+    int target_count;
+};
+
+// Distance weighted by how well the target is covered by its own side, so exposed enemies are
+// preferred over ones deep in their formation.  Influence is read in O(1) per candidate.  The
+// weight only ever makes a target count as farther away.
+static bool EnumerateBestTarget(UnitEntity* u, void* user_data) {
+    if (u->health <= 0.0f)
+        return true;
+
+    FindBestTargetArgs* args = static_cast<FindBestTargetArgs*>(user_data);
+    float cover = Max(0.0f, -GetInfluenceBalance(args->unit->team, XZ(u->position)));
+    float score = DistanceSqr(u, args->unit->position) * Sqr(1.0f + UNIT_TARGET_THREAT_WEIGHT * cover);
+    if (args->target_count == UNIT_TARGET_CANDIDATES && score >= args->target_scores[UNIT_TARGET_CANDIDATES - 1])
+        return true;
+
+    // Insertion into the short list sorted by score
+    int index = Min(args->target_count, UNIT_TARGET_CANDIDATES - 1);
+    for (; index > 0 && args->target_scores[index - 1] > score; index--) {
+        args->targets[index] = args->targets[index - 1];
+        args->target_scores[index] = args->target_scores[index - 1];
+    }
+
+    args->targets[index] = u;
+    args->target_scores[index] = score;
+    args->target_count = Min(args->target_count + 1, UNIT_TARGET_CANDIDATES);
+    return true;
+}
+
+// Searches the tiles in rings around the unit and stops once no unit on the next ring can beat
+// the worst candidate kept, a unit on ring r is at least r - 1 tiles away.  Static units are not
+// in the index and are scored from the obstacle list.  Line of sight is then traced through the
+// candidates best first, and the best one is taken when every one of them is blocked.
+static UnitEntity* FindBestTarget(UnitEntity* u) {
+    FindBestTargetArgs args {
+        .unit = u,
+        .targets = {},
+        .target_scores = {},
+        .target_count = 0
+    };
+
+    Team team = GetOppositeTeam(u->team);
+    Vec2 position = XZ(u->position);
+    for (int ring = 0; ; ring++) {
+        if (args.target_count > 0 && Sqr(Max(ring - 1, 0) * WORLD_TILE_SIZE) >= args.target_scores[args.target_count - 1])
+            break;
+
+        if (!EnumerateUnitsInRing(team, position, ring, EnumerateBestTarget, &args))
+            break;
+    }
+
+    EnumerateStaticUnits(team, EnumerateBestTarget, &args);
+
+    for (int i = 0; i < args.target_count; i++) {
+        // Static targets are obstacles themselves and would always block their own line of sight
+        UnitEntity* target = args.targets[i];
+        if (target->is_static || HasLineOfSight(position, XZ(target->position)))
+            return target;
+    }
+
+    return args.target_count > 0 ? args.targets[0] : nullptr;
+}
+
 static void UpdateTarget(UnitEntity* u) {
     UnitEntity* target = GetUnit(u->target);
     if (target && target->health > 0.0f)
         return;
 
-    target = FindClosestEnemy(u);
+    target = FindBestTarget(u);
     if (!target)
         return;
 
@@ -314,12 +447,18 @@ static void UpdateTarget(UnitEntity* u) {
 }
 
 void UpdateUnit(UnitEntity* u) {
-    UpdateTarget(u);
-
     if (u->health <= 0.0f && u->state != UNIT_STATE_DEAD) {
         SetState(u, UNIT_STATE_DEAD);
     }
 
+    // May free the unit
+    if (u->state == UNIT_STATE_DEAD) {
+        UpdateDeadState(u);
+        return;
+    }
+
+    UpdateTarget(u);
+
     if (u->state == UNIT_STATE_IDLE)
         UpdateIdleState(u);
     else if (u->state == UNIT_STATE_MOVE)
@@ -328,11 +467,8 @@ void UpdateUnit(UnitEntity* u) {
         UpdateAttackState(u);
     else if (u->state == UNIT_STATE_RELOAD)
         UpdateReloadState(u);
-    else if (u->state == UNIT_STATE_DEAD)
-        UpdateDeadState(u);
 
-    if (u->state != UNIT_STATE_DEAD)
-        Update(u->animator, GetGameTimeScale());
+    UpdateAnimator(u, u->info->height);
 }
 
 void DrawGizmos(UnitEntity* u, const Mat3& transform) {
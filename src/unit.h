@@ -31,11 +31,25 @@ enum UnitState {
     UNIT_STATE_COUNT
 };
 
+constexpr int MAX_UNIT_ATTACHMENTS = 6;
+constexpr int MAX_UNIT_LIVE_ANIMATIONS = 5;
+
+// Mesh stuck to a bone of the unit, drawn with the unit's own parts.  Offset and rotation are in
+// the space of the bone so the attachment follows animation and ragdoll alike.
+struct UnitAttachment {
+    Mesh** mesh;
+    Vec2 offset;
+    float rotation;
+    int bone;
+    Team team;
+};
+
 struct UnitEntity : Entity {
     UnitType unit_type;
     UnitState state;
     Team team;
     float health;
+    float max_health;
     float size;
     float state_time;
     Vec3 velocity;
@@ -43,6 +57,10 @@ struct UnitEntity : Entity {
     EntityHandle target;
     const UnitInfo* info;
     float target_switch_cooldown;
+    bool is_static;
+    UnitAttachment attachments[MAX_UNIT_ATTACHMENTS];
+    int attachment_count;
+    int attachment_next;
 };
 
 struct ArcherEntity : UnitEntity {
@@ -67,6 +85,10 @@ union FatUnitEntity {
     TowerEntity tower;
 };
 
+constexpr u32 BONE_MASK_ALL = 0xFFFFFFFF;
+
+inline u32 BoneMask(int bone_index) { return 1u << bone_index; }
+
 typedef UnitEntity* (*UnitCreateFunc)(Team team, const Vec3& position);
 typedef void (*UnitAttackFunc)(UnitEntity* u, UnitEntity* target);
 
@@ -80,12 +102,16 @@ struct UnitInfo {
     UnitCreateFunc create_func;
     UnitAttackFunc attack_func;
     Mesh* icon_mesh;
+    u32 bone_mask;
 
     Animation* idle_animation;
     Animation* move_animation;
     Animation* shuffle_animation;
     Animation* attack_animation;
     Animation* reload_animation;
+
+    // Clips of this unit sampled from their keyframes every frame instead of from the baked table
+    Animation* live_animations[MAX_UNIT_LIVE_ANIMATIONS];
 };
 
 // @unit
@@ -148,10 +174,18 @@ extern void ApplyImpulse(UnitEntity* u, const Vec3& impulse);
 extern void UpdateUnit(UnitEntity* u);
 
 // @stick
-extern void DrawStick(Entity* e, const Mat3& transform, bool shadow);
+extern int DrawStick(Entity* e, float depth, bool shadow);
+extern bool DrawStickImpostor(Entity* e, const Mat3& transform, float depth, bool shadow);
+extern void BakeStick(Entity* e, const Mat3& transform);
+extern void InitRagdollPose();
 extern void EnableRagdoll(Entity* entity);
 extern void DisableRagdoll(Entity* entity);
-extern void UpdateStickRagdoll(Entity* entity, float dt);
+extern void UpdateStickRagdoll(Entity* entity);
+extern void UpdateRagdolls(float dt);
+extern bool IsRagdollSettled(Entity* entity);
+extern void SetRagdollBoneMask(u32 bone_mask);
+extern u32 GetStickBoneMask(u32 extra_mask = 0);
+extern void AttachToStick(UnitEntity* u, Mesh** mesh, const Vec2& position, const Vec2& direction, Team team);
 
 // @archer
 extern ArcherEntity* CreateArcher(Team team, const Vec3& position);
@@ -22,4 +22,9 @@ extern void InitArcherUnit();
 void InitUnitDatabase() {
     InitCowboyUnit();
     InitArcherUnit();
+
+    u32 bone_mask = 0;
+    for (const UnitInfo& unit_info : g_unit_database)
+        bone_mask |= unit_info.bone_mask;
+    SetRagdollBoneMask(bone_mask);
 }
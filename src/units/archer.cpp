@@ -18,23 +18,34 @@ inline ArcherEntity* CastArcher(Entity* e) {
     return a;
 }
 
+// Bones drawn by DrawArcherInternal on top of the stick parts
+constexpr u32 ARCHER_BONE_MASK = (1u << BONE_STICK_ITEM_B) | (1u << BONE_STICK_ITEM_F);
+
+static void DrawArcherMesh(Entity* e, Mesh* mesh, const Mat3& transform, float depth, Team team, bool shadow, int layer) {
+    if (shadow)
+        AddShadowDraw(mesh, transform);
+    else
+        AddDraw(DRAW_PASS_MAIN, g_game.material, mesh, transform, depth, COLOR_WHITE, GetTeamColorOffset(team), GetRenderIndex(e), layer);
+}
+
 void DrawArcherInternal(Entity* e, const Mat3& transform, bool shadow) {
     ArcherEntity* a = CastArcher(e);
-    DrawStick(e, transform, shadow);
-    DrawMesh(MESH_STICK_BOW, transform, e->animator, BONE_STICK_ITEM_B);
+    float depth = GetEntityDepth(e->position);
+    if (DrawStickImpostor(e, transform, depth, shadow))
+        return;
+
+    const Mat3* bones = shadow ? e->shadow_bones : e->world_bones;
+    int layer = DrawStick(e, depth, shadow);
+    DrawArcherMesh(e, MESH_STICK_BOW, bones[BONE_STICK_ITEM_B], depth, a->team, shadow, layer++);
 
     if (a->state == UNIT_STATE_RELOAD) {
-        DrawMesh(MESH_PROJECTILE_ARROW, transform, e->animator, BONE_STICK_ITEM_F);
+        DrawArcherMesh(e, MESH_PROJECTILE_ARROW, bones[BONE_STICK_ITEM_F], depth, a->team, shadow, layer);
     }
 }
 
 void DrawArcher(Entity* e, const Mat3& transform) {
-    BindDepth(0.0f - (e->position.y) * 5);
-    BindMaterial(g_game.material);
-    BindTeamColor(static_cast<UnitEntity*>(e)->team);
     DrawArcherInternal(e, transform, false);
 
-
     //DrawGizmos(static_cast<UnitEntity*>(e), transform);
 }
 
@@ -43,18 +54,16 @@ void DrawArcherShadow(Entity* e, const Mat3& transform) {
     DrawArcherInternal(a, transform, true);
 }
 
-static void UpdateArcherDead(Entity*) {
-    ///ArcherEntity* a = CastArcher(e);
-    //Update(a->animator, GetGameTimeScale() * 0.5f);
+static void BakeArcher(Entity* e, const Mat3& transform) {
+    ArcherEntity* a = CastArcher(e);
+    BakeStick(e, transform);
+    AddGroundMesh(&MESH_STICK_BOW, transform * e->bones[BONE_STICK_ITEM_B], a->team);
 }
 
 static void KillArcher(Entity* e, DamageType damage_type) {
     UnitEntity* u = static_cast<UnitEntity*>(e);
-    u->vtable.update = UpdateArcherDead;
     HandleUnitDeath(u, damage_type);
-    //Play(u->animator, ANIMATION_STICK_DEATH, 0.5f, false);
-    UpdateArcherDead(e);
-     Free(e);
+    SetState(u, UNIT_STATE_DEAD);
 }
 
 void UpdateArcher(Entity* e) {
@@ -78,7 +87,7 @@ void UpdateArcher(Entity* e) {
             a->cooldown = RandomFloat(ARCHER_COOLDOWN_MIN, ARCHER_COOLDOWN_MAX);
             //Play(a->animator, ANIMATION_STICK_BOW_DRAW, 1.0f, false);
             Damage(a->target, DAMAGE_TYPE_PHYSICAL, ARCHER_DAMAGE);
-            Play(VFX_ARROW_HIT, WorldToScreen(a->target->position));
+            TriggerVfx(VFX_ARROW_HIT, WorldToScreen(a->target->position));
             Vec2 hand = TRS(XY(a->position), 0.0f, a->scale) * a->animator.bones[BONE_STICK_HAND_B] * VEC2_ZERO;
             CreateArrow(
                 a->team,
@@ -101,7 +110,8 @@ ArcherEntity* CreateArcher(Team team, const Vec3& position) {
         .update = UpdateArcher,
         .draw = DrawArcher,
         .draw_shadow = DrawArcherShadow,
-        .death = KillArcher
+        .death = KillArcher,
+        .bake = BakeArcher
     };
 
     ArcherEntity* a = static_cast<ArcherEntity*>(CreateUnit(
@@ -112,6 +122,7 @@ ArcherEntity* CreateArcher(Team team, const Vec3& position) {
         0.0f,
         {GetTeamDirection(team).x, 1.0f}));
     a->health = ARCHER_HEALTH;
+    a->max_health = ARCHER_HEALTH;
     a->size = ARCHER_SIZE;
     a->cooldown = RandomFloat(ARCHER_COOLDOWN_MIN, ARCHER_COOLDOWN_MAX);
 
@@ -122,7 +133,7 @@ ArcherEntity* CreateArcher(Team team, const Vec3& position) {
 
 static void FireArrow(UnitEntity* u, UnitEntity* target) {
     ArcherEntity* a = static_cast<ArcherEntity*>(u);
-    Vec2 hand = TransformPoint(TRS(VEC2_ZERO, 0.0f, a->scale) * a->animator.bones[BONE_STICK_HAND_B]);
+    Vec2 hand = TransformPoint(TRS(VEC2_ZERO, 0.0f, a->scale) * a->bones[BONE_STICK_HAND_B]);
     CreateArrow(
         a->team,
         a->position + Vec3{hand.x, hand.y, 0.0f},
@@ -141,6 +152,7 @@ void InitArcherUnit() {
         .create_func = (UnitCreateFunc)CreateArcher,
         .attack_func = (UnitAttackFunc)FireArrow,
         .icon_mesh = MESH_COWBOY_ICON,
+        .bone_mask = GetStickBoneMask(ARCHER_BONE_MASK),
         .idle_animation = ANIMATION_ARCHER_IDLE,
         .move_animation = ANIMATION_STICK_RUN,
         .shuffle_animation = ANIMATION_ARCHER_SHUFFLE,
@@ -154,11 +166,13 @@ ArcherEntity* CreateArcher2(Team team, const Vec3& position) {
         .update = UpdateArcher,
         .draw = DrawArcher,
         .draw_shadow = DrawArcherShadow,
-        .death = KillArcher
+        .death = KillArcher,
+        .bake = BakeArcher
     };
 
     ArcherEntity* a = static_cast<ArcherEntity*>(CreateUnit(UNIT_TYPE_COWBOY, team, vtable, position, 0.0f, {GetTeamDirection(team).x, 1.0f}));
     a->health = ARCHER_HEALTH;
+    a->max_health = ARCHER_HEALTH;
     a->size = ARCHER_SIZE;
     a->cooldown = RandomFloat(ARCHER_COOLDOWN_MIN, ARCHER_COOLDOWN_MAX);
 
@@ -176,6 +190,7 @@ void InitCowboyUnit() {
         .speed = ARCHER_SPEED,
         .create_func = (UnitCreateFunc)CreateArcher2,
         .icon_mesh = MESH_COWBOY_ICON,
+        .bone_mask = GetStickBoneMask(ARCHER_BONE_MASK),
         .idle_animation = ANIMATION_ARCHER_IDLE,
         .move_animation = ANIMATION_STICK_RUN,
         .shuffle_animation = ANIMATION_ARCHER_SHUFFLE,
@@ -104,9 +104,9 @@ void UpdateCowboy(Entity*) {
             a->cooldown = RandomFloat(COWBOY_COOLDOWN_MIN, COWBOY_COOLDOWN_MAX);
             Damage(args.target, DAMAGE_TYPE_PHYSICAL, COWBOY_DAMAGE);
             Vec2 gun = TransformPoint(TRS(XY(a->position), 0.0f, a->scale) * a->animator.bones[BONE_COWBOY_HAND_R]);
-            Play(VFX_BOW_FIRE, WorldToScreen(Vec3{gun.x, gun.y, 0.0f}));
+            TriggerVfx(VFX_BOW_FIRE, WorldToScreen(Vec3{gun.x, gun.y, 0.0f}), VFX_PRIORITY_HIGH);
             Play(a->animator, ANIMATION_COWBOY_SHOOT, 1.0f, false);
-            Play(SOUND_REVOLVER_FIRE_A, 0.5f, RandomFloat(0.95f, 1.05f));
+            TriggerSound(SOUND_REVOLVER_FIRE_A, WorldToScreen(Vec3{gun.x, gun.y, 0.0f}), 0.5f);
             CreateBullet(a->team, Vec3{gun.x, gun.y, 0.0f}, XY(args.target->position), COWBOY_BULLET_SPEED);
         } else if (a->animator.animation != ANIMATION_COWBOY_IDLE && a->animator.animation != ANIMATION_COWBOY_SHOOT) {
             Play(a->animator, ANIMATION_COWBOY_IDLE, 1.0f, true);
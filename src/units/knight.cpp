@@ -78,7 +78,7 @@ void UpdateArrow(Entity*)
         u->cooldown = KNIGHT_COOLDOWN;
         u->state = UNIT_STATE_ATTACK;
         Damage(args.target, DAMAGE_TYPE_PHYSICAL, KNIGHT_DAMAGE);
-        Play(VFX_ARROW_HIT, WorldToScreen(args.target->position));
+        TriggerVfx(VFX_ARROW_HIT, WorldToScreen(args.target->position), VFX_PRIORITY_HIGH);
         //Play(u->animator, ANIMATION_UNIT_KNIGHT_ATTACK, 1.0f, false);
     } else if (u->state != UNIT_STATE_IDLE && (IsLooping(u->animator) || !IsPlaying(u->animator))) {
         SetKnightIdleState(u);
@@ -95,6 +95,7 @@ KnightEntity* CreateKnight(Team team, const Vec3& position)
 
     KnightEntity* k = static_cast<KnightEntity*>(CreateUnit(UNIT_TYPE_KNIGHT, team, vtable, position, 0.0f, {GetTeamDirection(team).x, 1.0f}));
     k->health = KNIGHT_HEALTH;
+    k->max_health = KNIGHT_HEALTH;
     k->size = 1.0f;
     // Init(k->animator, SKELETON_UNIT_KNIGHT);
     // Play(k->animator, ANIMATION_UNIT_KNIGHT_IDLE, 1.0f, true);
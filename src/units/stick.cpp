@@ -2,180 +2,493 @@
 //  Battle TowerZ - Copyright(c) 2025 NoZ Games, LLC
 //
 
-// Simple ragdoll bone structure
+constexpr int MAX_RAGDOLLS = MAX_UNITS;
+
+static_assert(BONE_STICK_COUNT <= 32, "stick bones must fit in a bone mask");
+
+struct StickPart {
+    Mesh** mesh;
+    int bone;
+};
+
+// Meshes that make up a stick figure, in draw order
+static const StickPart STICK_PARTS[] = {
+    { &MESH_STICK_ARM_L_R, BONE_STICK_ARM_LOWER_B },
+    { &MESH_STICK_ARM_U_R, BONE_STICK_ARM_UPPER_B },
+    { &MESH_STICK_ARM_L_L, BONE_STICK_ARM_LOWER_F },
+    { &MESH_STICK_ARM_U_L, BONE_STICK_ARM_UPPER_F },
+    { &MESH_STICK_HAND_R, BONE_STICK_HAND_B },
+    { &MESH_STICK_HAND_L, BONE_STICK_HAND_F },
+    { &MESH_STICK_LEG_U_R, BONE_STICK_LEG_UPPER_B },
+    { &MESH_STICK_LEG_L_R, BONE_STICK_LEG_LOWER_B },
+    { &MESH_STICK_LEG_L_L, BONE_STICK_LEG_LOWER_F },
+    { &MESH_STICK_LEG_U_L, BONE_STICK_LEG_UPPER_F },
+    { &MESH_STICK_HIP, BONE_STICK_HIP },
+    { &MESH_STICK_BODY_B, BONE_STICK_SPINE },
+    { &MESH_STICK_BODY, BONE_STICK_CHEST },
+    { &MESH_STICK_NECK, BONE_STICK_NECK },
+    { &MESH_STICK_HEAD, BONE_STICK_HEAD },
+    // { &MESH_STICK_EYE, BONE_STICK_EYE_F },
+    // { &MESH_STICK_EYE, BONE_STICK_EYE_B },
+};
+
+static_assert(sizeof(STICK_PARTS) / sizeof(StickPart) + MAX_UNIT_ATTACHMENTS < MAX_DRAW_LAYERS, "stick parts need a draw layer each");
+
+// Bones that attachments can stick to
+static const int STICK_ATTACH_BONES[] = {
+    BONE_STICK_HIP,
+    BONE_STICK_SPINE,
+    BONE_STICK_CHEST,
+    BONE_STICK_HEAD,
+    BONE_STICK_ARM_UPPER_F,
+    BONE_STICK_ARM_UPPER_B,
+    BONE_STICK_LEG_UPPER_F,
+    BONE_STICK_LEG_UPPER_B,
+};
+
+// Ragdoll bone rest data, shared by every stick ragdoll and built by InitRagdollPose
 struct RagdollBone {
-    Vec2 position;
     Vec2 offset;
-    Vec2 velocity;
     float rotation;
-    float angular_velocity;
     int parent_index;
     float length;
     bool is_root;
 };
 
-// Ragdoll state
-struct StickRagdoll {
-    RagdollBone bones[BONE_STICK_COUNT]; // One for each stick bone
-    bool active;
-    float ground_y;
+// All active ragdolls are stepped together.  Bone state is stored as structure of arrays indexed
+// by [bone][ragdoll] so the inner loops run over contiguous ragdolls and vectorize.
+struct RagdollSystem {
+    RagdollBone bones[BONE_STICK_COUNT];
+    int active_bones[BONE_STICK_COUNT];
+    int active_bone_count;
+    float x[BONE_STICK_COUNT][MAX_RAGDOLLS];
+    float y[BONE_STICK_COUNT][MAX_RAGDOLLS];
+    float prev_x[BONE_STICK_COUNT][MAX_RAGDOLLS];
+    float prev_y[BONE_STICK_COUNT][MAX_RAGDOLLS];
+    float velocity_x[BONE_STICK_COUNT][MAX_RAGDOLLS];
+    float velocity_y[BONE_STICK_COUNT][MAX_RAGDOLLS];
+    float start_angle[BONE_STICK_COUNT][MAX_RAGDOLLS];
+    float ground_y[MAX_RAGDOLLS];
+    float speed_sqr[MAX_RAGDOLLS];
+    float rest_time[MAX_RAGDOLLS];
+    EntityHandle owners[MAX_RAGDOLLS];
+    int slots[MAX_ENTITIES];
+    int count;
 };
 
 // Simple ragdoll physics constants
 constexpr float RAGDOLL_GRAVITY = 98.0f;
-constexpr float RAGDOLL_DAMPING = 0.98f;
-constexpr float RAGDOLL_ANGULAR_DAMPING = 0.95f;
 constexpr float RAGDOLL_BOUNCE = 0.3f;
 constexpr float RAGDOLL_FRICTION = 40.0f;
+constexpr float RAGDOLL_REST_SPEED = 0.5f;
+constexpr float RAGDOLL_SETTLE_SPEED = 0.05f;
+constexpr float RAGDOLL_SETTLE_TIME = 0.5f;
 constexpr float RAGDOLL_EXPLODE_VELOCITY_X = 5.0f;
 constexpr float RAGDOLL_EXPLODE_VELOCITY_Y = 20.0f;
+constexpr int RAGDOLL_ITERATIONS = 4;
+constexpr int RAGDOLL_BATCH_SIZE = 128;
 
-// Initialize ragdoll for a stick figure
-static void InitRagdoll(StickRagdoll& ragdoll, Entity* entity) {
-    ragdoll.active = true;
-    ragdoll.ground_y = entity->position.y;
-
-    // Stop(entity->animator);
-    // Play(entity->animator, ANIMATION_STICK_DEAD, 1.0f, false);
-    // Update(entity->animator, 1.0f);
+static RagdollSystem g_ragdolls = {};
 
+// The death pose never changes, so the rest directions and offsets are computed once when
+// the assets load and every ragdoll starts from this table.
+void InitRagdollPose() {
     Animator test = {};
     Init(test, SKELETON_STICK);
     Play(test, ANIMATION_STICK_DEAD, 1.0f, false);
     Update(test, 1.0f);
 
-    float h = 0.4f;
-
-    // Initialize bones from current animator pose
     Skeleton* skeleton = SKELETON_STICK;
     for (int bone_index = 0; bone_index < BONE_STICK_COUNT; bone_index++) {
         const Bone& bone = GetBone(skeleton, bone_index);
         const Transform& bone_transform = GetBoneTransform(skeleton, bone_index);
 
-        RagdollBone& ragdoll_bone = ragdoll.bones[bone_index];
+        RagdollBone& ragdoll_bone = g_ragdolls.bones[bone_index];
         ragdoll_bone.parent_index = bone.parent_index;
         ragdoll_bone.length = Length(bone_transform.position);
         ragdoll_bone.is_root = bone_index == 0;
-
-        Vec2 bone_pos = TransformPoint(entity->animator.bones[bone_index]);
-        ragdoll_bone.position = bone_pos;
         ragdoll_bone.rotation = 0.0f;
-        //ragdoll_bone.velocity = Vec2{RandomFloat(RAGDOLL_EXPLODE_VELOCITY_X * 0.5f, RAGDOLL_EXPLODE_VELOCITY_X), RandomFloat(RAGDOLL_EXPLODE_VELOCITY_Y * 0.5f, RAGDOLL_EXPLODE_VELOCITY_Y)};
-
-        ragdoll_bone.velocity = Vec2{
-            (1.0f - Abs(bone_pos.y - h) / h) * RAGDOLL_EXPLODE_VELOCITY_X,
-            ((bone_pos.y - h) / h) * RAGDOLL_EXPLODE_VELOCITY_Y};
-
-        //ragdoll_bone.angular_velocity = RandomFloat(-5.0f, 5.0f);
+        ragdoll_bone.offset = VEC2_ZERO;
 
         if (bone_index > 0) {
             Vec2 b = TransformPoint(test.bones[bone_index], Vec2{1,0});
             Vec2 bp = TransformPoint(test.bones[bone_index]);
             Vec2 dir = Normalize(b - bp);
-            ragdoll_bone.rotation = Angle(dir); //   SignedAngleDelta(bone.transform.rotation, Angle(dir));
+            ragdoll_bone.rotation = Angle(dir);
             ragdoll_bone.offset = {0, bp.y};
         }
-        // Extract position and rotation from current bone transform
     }
 }
 
-// Update ragdoll physics
-static void UpdateRagdoll(StickRagdoll& ragdoll, float dt) {
-    if (!ragdoll.active) return;
-
-    for (int i = 0; i < BONE_STICK_COUNT; i++) {
-        RagdollBone& bone = ragdoll.bones[i];
-        bone.velocity.y -= RAGDOLL_GRAVITY * dt;
-        //bone.velocity *= RAGDOLL_DAMPING;
-        //bone.angular_velocity *= RAGDOLL_ANGULAR_DAMPING;
-        bone.position += bone.velocity * dt;
-        //bone.rotation += bone.angular_velocity * dt;
-
-        //bone.position = Normalize(bone.position) * bone.length;
-
-        // Ground collision
-        if (bone.position.y <= ragdoll.ground_y) {
-            bone.position.y = ragdoll.ground_y;
-            bone.velocity.y = -bone.velocity.y * RAGDOLL_BOUNCE;
-
-            // Stop bouncing if velocity is very small4
-            if (Abs(bone.velocity.y) < 0.5f) {
-                bone.velocity.y = 0.0f;
-
-                if (bone.velocity.x != 0.0f) {
-                    float old_x_velocity = bone.velocity.x;
-                    bone.velocity.x -= RAGDOLL_FRICTION * dt;
-                    if (old_x_velocity * bone.velocity.x < 0.0f) {
-                        bone.velocity.x = 0.0f;
-                    }
-                }
+// Only bones that some unit type draws are simulated.  Bones are kept in index order, parents
+// before children, so a mask closed over its ancestors keeps every constraint intact.
+void SetRagdollBoneMask(u32 bone_mask) {
+    if (bone_mask == 0)
+        bone_mask = BONE_MASK_ALL;
+
+    g_ragdolls.active_bone_count = 0;
+    for (int bone_index = 0; bone_index < BONE_STICK_COUNT; bone_index++)
+        if (bone_mask & BoneMask(bone_index))
+            g_ragdolls.active_bones[g_ragdolls.active_bone_count++] = bone_index;
+}
+
+// Bones used by the stick parts plus any extra bones, along with every ancestor needed to pose them
+u32 GetStickBoneMask(u32 extra_mask) {
+    u32 bone_mask = extra_mask;
+    for (const StickPart& part : STICK_PARTS)
+        bone_mask |= BoneMask(part.bone);
+
+    Skeleton* skeleton = SKELETON_STICK;
+    for (int bone_index = BONE_STICK_COUNT - 1; bone_index >= 0; bone_index--) {
+        if (!(bone_mask & BoneMask(bone_index)))
+            continue;
+
+        for (int parent_index = GetBone(skeleton, bone_index).parent_index; parent_index >= 0; parent_index = GetBone(skeleton, parent_index).parent_index)
+            bone_mask |= BoneMask(parent_index);
+    }
+
+    return bone_mask;
+}
+
+static float GetSegmentAngle(int bone_index, int slot) {
+    int parent_index = g_ragdolls.bones[bone_index].parent_index;
+    if (parent_index < 0)
+        return 0.0f;
+
+    return Angle(Vec2{
+        g_ragdolls.x[bone_index][slot] - g_ragdolls.x[parent_index][slot],
+        g_ragdolls.y[bone_index][slot] - g_ragdolls.y[parent_index][slot]});
+}
+
+// Initialize ragdoll for a stick figure
+static void InitRagdoll(int slot, Entity* entity) {
+    g_ragdolls.owners[slot] = GetHandle(entity);
+    g_ragdolls.ground_y[slot] = entity->position.y;
+    g_ragdolls.rest_time[slot] = 0.0f;
+
+    float h = 0.4f;
+
+    // Initialize bones from current animator pose
+    for (int active_index = 0; active_index < g_ragdolls.active_bone_count; active_index++) {
+        int bone_index = g_ragdolls.active_bones[active_index];
+        Vec2 bone_pos = TransformPoint(entity->bones[bone_index]);
+        g_ragdolls.x[bone_index][slot] = bone_pos.x;
+        g_ragdolls.y[bone_index][slot] = bone_pos.y;
+        g_ragdolls.velocity_x[bone_index][slot] = (1.0f - Abs(bone_pos.y - h) / h) * RAGDOLL_EXPLODE_VELOCITY_X;
+        g_ragdolls.velocity_y[bone_index][slot] = ((bone_pos.y - h) / h) * RAGDOLL_EXPLODE_VELOCITY_Y;
+    }
+
+    for (int active_index = 0; active_index < g_ragdolls.active_bone_count; active_index++) {
+        int bone_index = g_ragdolls.active_bones[active_index];
+        g_ragdolls.start_angle[bone_index][slot] = GetSegmentAngle(bone_index, slot);
+    }
+}
+
+static void RemoveRagdoll(int slot) {
+    assert(slot >= 0 && slot < g_ragdolls.count);
+
+    EntityHandle owner = g_ragdolls.owners[slot];
+    g_ragdolls.slots[owner.index - 1] = 0;
+
+    int last = --g_ragdolls.count;
+    if (slot == last)
+        return;
+
+    for (int active_index = 0; active_index < g_ragdolls.active_bone_count; active_index++) {
+        int bone_index = g_ragdolls.active_bones[active_index];
+        g_ragdolls.x[bone_index][slot] = g_ragdolls.x[bone_index][last];
+        g_ragdolls.y[bone_index][slot] = g_ragdolls.y[bone_index][last];
+        g_ragdolls.velocity_x[bone_index][slot] = g_ragdolls.velocity_x[bone_index][last];
+        g_ragdolls.velocity_y[bone_index][slot] = g_ragdolls.velocity_y[bone_index][last];
+        g_ragdolls.start_angle[bone_index][slot] = g_ragdolls.start_angle[bone_index][last];
+    }
+
+    g_ragdolls.ground_y[slot] = g_ragdolls.ground_y[last];
+    g_ragdolls.rest_time[slot] = g_ragdolls.rest_time[last];
+    g_ragdolls.owners[slot] = g_ragdolls.owners[last];
+    g_ragdolls.slots[g_ragdolls.owners[slot].index - 1] = slot + 1;
+}
+
+static int GetRagdollSlot(Entity* entity) {
+    EntityHandle handle = GetHandle(entity);
+    int slot = g_ragdolls.slots[handle.index - 1] - 1;
+    if (slot < 0)
+        return -1;
+
+    // Slot left behind by a freed entity that has not been swept yet
+    if (g_ragdolls.owners[slot].generation != handle.generation) {
+        RemoveRagdoll(slot);
+        return -1;
+    }
+
+    return slot;
+}
+
+// Verlet style position based step: integrate, satisfy bone lengths and the ground with a fixed
+// number of iterations, then derive the velocities back from the corrected positions.
+static void StepRagdolls(int start, int end, void* user_data) {
+    float dt = *static_cast<float*>(user_data);
+    float gravity = RAGDOLL_GRAVITY * dt;
+    float* ground_y = g_ragdolls.ground_y;
+
+    for (int active_index = 0; active_index < g_ragdolls.active_bone_count; active_index++) {
+        int bone_index = g_ragdolls.active_bones[active_index];
+        float* x = g_ragdolls.x[bone_index];
+        float* y = g_ragdolls.y[bone_index];
+        float* prev_x = g_ragdolls.prev_x[bone_index];
+        float* prev_y = g_ragdolls.prev_y[bone_index];
+        float* velocity_x = g_ragdolls.velocity_x[bone_index];
+        float* velocity_y = g_ragdolls.velocity_y[bone_index];
+        for (int i = start; i < end; i++) {
+            velocity_y[i] -= gravity;
+            prev_x[i] = x[i];
+            prev_y[i] = y[i];
+            x[i] += velocity_x[i] * dt;
+            y[i] += velocity_y[i] * dt;
+        }
+    }
+
+    for (int iteration = 0; iteration < RAGDOLL_ITERATIONS; iteration++) {
+        for (int active_index = 0; active_index < g_ragdolls.active_bone_count; active_index++) {
+            int bone_index = g_ragdolls.active_bones[active_index];
+            const RagdollBone& bone = g_ragdolls.bones[bone_index];
+            if (bone.parent_index < 0)
+                continue;
+
+            float length = bone.length;
+            float* x = g_ragdolls.x[bone_index];
+            float* y = g_ragdolls.y[bone_index];
+            float* parent_x = g_ragdolls.x[bone.parent_index];
+            float* parent_y = g_ragdolls.y[bone.parent_index];
+            for (int i = start; i < end; i++) {
+                float dx = x[i] - parent_x[i];
+                float dy = y[i] - parent_y[i];
+                float distance = sqrtf(dx * dx + dy * dy);
+                float correction = distance > F32_EPSILON ? 0.5f * (distance - length) / distance : 0.0f;
+                x[i] -= dx * correction;
+                y[i] -= dy * correction;
+                parent_x[i] += dx * correction;
+                parent_y[i] += dy * correction;
             }
         }
+
+        for (int active_index = 0; active_index < g_ragdolls.active_bone_count; active_index++) {
+            int bone_index = g_ragdolls.active_bones[active_index];
+            float* y = g_ragdolls.y[bone_index];
+            for (int i = start; i < end; i++)
+                y[i] = y[i] < ground_y[i] ? ground_y[i] : y[i];
+        }
     }
+
+    float inv_dt = 1.0f / dt;
+    float friction = RAGDOLL_FRICTION * dt;
+    float* speed_sqr = g_ragdolls.speed_sqr;
+    for (int i = start; i < end; i++)
+        speed_sqr[i] = 0.0f;
+
+    for (int active_index = 0; active_index < g_ragdolls.active_bone_count; active_index++) {
+        int bone_index = g_ragdolls.active_bones[active_index];
+        float* x = g_ragdolls.x[bone_index];
+        float* y = g_ragdolls.y[bone_index];
+        float* prev_x = g_ragdolls.prev_x[bone_index];
+        float* prev_y = g_ragdolls.prev_y[bone_index];
+        float* velocity_x = g_ragdolls.velocity_x[bone_index];
+        float* velocity_y = g_ragdolls.velocity_y[bone_index];
+        for (int i = start; i < end; i++) {
+            float vx = (x[i] - prev_x[i]) * inv_dt;
+            float vy = (y[i] - prev_y[i]) * inv_dt;
+
+            // Bounce off the ground using the incoming velocity.  A bone that was lying still only
+            // picked up this step's gravity, which grows with dt, so that much is never bounced back
+            // and the rest test holds at any frame rate.
+            bool grounded = y[i] <= ground_y[i];
+            bool resting = grounded && velocity_y[i] > -(gravity + RAGDOLL_REST_SPEED);
+            vy = grounded && velocity_y[i] < 0.0f ? -velocity_y[i] * RAGDOLL_BOUNCE : vy;
+            vy = resting ? 0.0f : vy;
+            vx = resting ? (vx > friction ? vx - friction : (vx < -friction ? vx + friction : 0.0f)) : vx;
+
+            velocity_x[i] = vx;
+            velocity_y[i] = vy;
+
+            float bone_speed_sqr = vx * vx + vy * vy;
+            speed_sqr[i] = bone_speed_sqr > speed_sqr[i] ? bone_speed_sqr : speed_sqr[i];
+        }
+    }
+
+    // A ragdoll is settled once all of its bones stayed slow for a while
+    float* rest_time = g_ragdolls.rest_time;
+    float settle_speed_sqr = RAGDOLL_SETTLE_SPEED * RAGDOLL_SETTLE_SPEED;
+    for (int i = start; i < end; i++)
+        rest_time[i] = speed_sqr[i] < settle_speed_sqr ? rest_time[i] + dt : 0.0f;
+}
+
+void UpdateRagdolls(float dt) {
+    // Sweep ragdolls whose entity was freed
+    for (int slot = g_ragdolls.count - 1; slot >= 0; slot--)
+        if (!GetEntity(g_ragdolls.owners[slot]))
+            RemoveRagdoll(slot);
+
+    if (dt <= F32_EPSILON)
+        return;
+
+    RunParallel(StepRagdolls, g_ragdolls.count, RAGDOLL_BATCH_SIZE, &dt);
 }
 
-static void ApplyRagdollToAnimator(StickRagdoll& ragdoll, Animator& animator) {
-    if (!ragdoll.active) return;
+// Draws the entity as a single impostor mesh when the animator picked one
+bool DrawStickImpostor(Entity* e, const Mat3& transform, float depth, bool shadow) {
+    if (!e->impostor)
+        return false;
+
+    if (shadow)
+        AddShadowDraw(e->impostor, transform);
+    else
+        AddDraw(DRAW_PASS_MAIN, g_game.material, e->impostor, transform, depth, COLOR_WHITE, GetTeamColorOffset(static_cast<UnitEntity*>(e)->team), GetRenderIndex(e));
+
+    return true;
+}
 
-    for (int i = 0; i < BONE_STICK_COUNT; i++) {
-        const RagdollBone& ragdoll_bone = ragdoll.bones[i];
-        animator.bones[i] = TRS(ragdoll_bone.position + ragdoll_bone.offset, ragdoll_bone.rotation, VEC2_ONE);
+static Mat3 GetAttachmentTransform(const UnitAttachment& attachment) {
+    return TRS(attachment.offset, attachment.rotation, VEC2_ONE);
+}
+
+// Parts and attachments are added to the draw list from the world space bones computed by
+// UpdateWorldBones.  Parts are layered in table order with the attachments on top, the layer
+// after the last one used is returned for meshes drawn over the stick.
+int DrawStick(Entity* e, float depth, bool shadow) {
+    UnitEntity* u = static_cast<UnitEntity*>(e);
+    int layer = 0;
+    if (shadow) {
+        assert(e->shadow_bones);
+        for (const StickPart& part : STICK_PARTS)
+            AddShadowDraw(*part.mesh, e->shadow_bones[part.bone]);
+        for (int i = 0; i < u->attachment_count; i++) {
+            const UnitAttachment& attachment = u->attachments[i];
+            AddShadowDraw(*attachment.mesh, e->shadow_bones[attachment.bone] * GetAttachmentTransform(attachment));
+        }
+        return layer;
+    }
+
+    assert(e->world_bones);
+    Vec2 color_offset = GetTeamColorOffset(u->team);
+    int entity = GetRenderIndex(e);
+    for (const StickPart& part : STICK_PARTS)
+        AddDraw(DRAW_PASS_MAIN, g_game.material, *part.mesh, e->world_bones[part.bone], depth, COLOR_WHITE, color_offset, entity, layer++);
+
+    for (int i = 0; i < u->attachment_count; i++) {
+        const UnitAttachment& attachment = u->attachments[i];
+        AddDraw(
+            DRAW_PASS_MAIN,
+            g_game.material,
+            *attachment.mesh,
+            e->world_bones[attachment.bone] * GetAttachmentTransform(attachment),
+            depth,
+            COLOR_WHITE,
+            GetTeamColorOffset(attachment.team),
+            entity,
+            layer++);
+    }
+
+    return layer;
+}
+
+void BakeStick(Entity* e, const Mat3& transform) {
+    UnitEntity* u = static_cast<UnitEntity*>(e);
+    for (const StickPart& part : STICK_PARTS)
+        AddGroundMesh(part.mesh, transform * e->bones[part.bone], u->team);
+
+    for (int i = 0; i < u->attachment_count; i++) {
+        const UnitAttachment& attachment = u->attachments[i];
+        AddGroundMesh(attachment.mesh, transform * e->bones[attachment.bone] * GetAttachmentTransform(attachment), attachment.team);
     }
 }
 
-void DrawStick(Entity* e, const Mat3& transform, bool ) {
-    DrawMesh(MESH_STICK_ARM_L_R, transform, e->animator, BONE_STICK_ARM_LOWER_B);
-    DrawMesh(MESH_STICK_ARM_U_R, transform, e->animator, BONE_STICK_ARM_UPPER_B);
-    DrawMesh(MESH_STICK_ARM_L_L, transform, e->animator, BONE_STICK_ARM_LOWER_F);
-    DrawMesh(MESH_STICK_ARM_U_L, transform, e->animator, BONE_STICK_ARM_UPPER_F);
-    DrawMesh(MESH_STICK_HAND_R, transform, e->animator, BONE_STICK_HAND_B);
-    DrawMesh(MESH_STICK_HAND_L, transform, e->animator, BONE_STICK_HAND_F);
-    DrawMesh(MESH_STICK_LEG_U_R, transform, e->animator, BONE_STICK_LEG_UPPER_B);
-    DrawMesh(MESH_STICK_LEG_L_R, transform, e->animator, BONE_STICK_LEG_LOWER_B);
-    DrawMesh(MESH_STICK_LEG_L_L, transform, e->animator, BONE_STICK_LEG_LOWER_F);
-    DrawMesh(MESH_STICK_LEG_U_L, transform, e->animator, BONE_STICK_LEG_UPPER_F);
-    DrawMesh(MESH_STICK_HIP, transform, e->animator, BONE_STICK_HIP);
-    DrawMesh(MESH_STICK_BODY_B, transform, e->animator, BONE_STICK_SPINE);
-    DrawMesh(MESH_STICK_BODY, transform, e->animator, BONE_STICK_CHEST);
-    DrawMesh(MESH_STICK_NECK, transform, e->animator, BONE_STICK_NECK);
-    DrawMesh(MESH_STICK_HEAD, transform, e->animator, BONE_STICK_HEAD);
-    // DrawMesh(e->health <= 0 ? MESH_STICK_EYE_DEAD : MESH_STICK_EYE, transform, e->animator, BONE_STICK_EYE_F);
-    // DrawMesh(e->health <= 0 ? MESH_STICK_EYE_DEAD : MESH_STICK_EYE, transform, e->animator, BONE_STICK_EYE_B);
+// Sticks the mesh to the closest drawn body bone at a screen space position and direction.  The
+// attachment is stored in the space of the bone, so it costs nothing until the unit is drawn.
+void AttachToStick(UnitEntity* u, Mesh** mesh, const Vec2& position, const Vec2& direction, Team team) {
+    if (!u->bones || !u->info || !u->info->bone_mask)
+        return;
+
+    Mat3 transform = GetEntityTransform(u);
+    int best_bone = -1;
+    float best_distance = F32_MAX;
+    for (int bone_index : STICK_ATTACH_BONES) {
+        if (!(u->info->bone_mask & BoneMask(bone_index)))
+            continue;
+
+        float distance = LengthSqr(TransformPoint(transform * u->bones[bone_index]) - position);
+        if (distance < best_distance) {
+            best_distance = distance;
+            best_bone = bone_index;
+        }
+    }
+
+    if (best_bone == -1)
+        return;
+
+    // Solve for the bone space offset and direction with the inverse of the bone's 2x2 basis
+    Mat3 bone_transform = transform * u->bones[best_bone];
+    Vec2 axis_x = TransformVector(bone_transform, VEC2_RIGHT);
+    Vec2 axis_y = TransformVector(bone_transform, VEC2_UP);
+    float det = axis_x.x * axis_y.y - axis_x.y * axis_y.x;
+    if (Abs(det) <= F32_EPSILON)
+        return;
+
+    Vec2 delta = position - TransformPoint(bone_transform);
+    Vec2 offset = {
+        (delta.x * axis_y.y - delta.y * axis_y.x) / det,
+        (axis_x.x * delta.y - axis_x.y * delta.x) / det
+    };
+    Vec2 local_direction = {
+        (direction.x * axis_y.y - direction.y * axis_y.x) / det,
+        (axis_x.x * direction.y - axis_x.y * direction.x) / det
+    };
+
+    // The ring keeps the newest attachments
+    u->attachments[u->attachment_next] = { mesh, offset, Angle(Normalize(local_direction)), best_bone, team };
+    u->attachment_next = (u->attachment_next + 1) % MAX_UNIT_ATTACHMENTS;
+    u->attachment_count = Min(u->attachment_count + 1, MAX_UNIT_ATTACHMENTS);
 }
 
 void BindTeamColor(Team team) {
     BindColor(COLOR_WHITE, GetTeamColorOffset(team));
 }
 
-// Public ragdoll API
-// Store ragdoll per entity (simple global for now, could be extended)
-static StickRagdoll g_entity_ragdolls[1024];
-static bool g_entity_has_ragdoll[1024];
-
 void EnableRagdoll(Entity* entity) {
-    size_t index = GetIndex(g_game.entity_allocator, entity);
-    if (index >= 1024) return;
+    if (GetRagdollSlot(entity) != -1)
+        return;
 
-    if (!g_entity_has_ragdoll[index]) {
-        InitRagdoll(g_entity_ragdolls[index], entity);
-        g_entity_has_ragdoll[index] = true;
-    }
+    if (g_ragdolls.count >= MAX_RAGDOLLS)
+        return;
+
+    int slot = g_ragdolls.count++;
+    g_ragdolls.slots[GetHandle(entity).index - 1] = slot + 1;
+    InitRagdoll(slot, entity);
 }
 
 void DisableRagdoll(Entity* entity) {
-    size_t index = GetIndex(g_game.entity_allocator, entity);
-    if (index >= 1024) return;
+    int slot = GetRagdollSlot(entity);
+    if (slot != -1)
+        RemoveRagdoll(slot);
+}
 
-    g_entity_ragdolls[index].active = false;
-    g_entity_has_ragdoll[index] = false;
+bool IsRagdollSettled(Entity* entity) {
+    int slot = GetRagdollSlot(entity);
+    return slot != -1 && g_ragdolls.rest_time[slot] >= RAGDOLL_SETTLE_TIME;
 }
 
-void UpdateStickRagdoll(Entity* entity, float dt) {
-    size_t index = GetIndex(g_game.entity_allocator, entity);
-    if (index >= 1024) return;
+void UpdateStickRagdoll(Entity* entity) {
+    int slot = GetRagdollSlot(entity);
+    if (slot == -1)
+        return;
 
-    if (g_entity_has_ragdoll[index]) {
-        UpdateRagdoll(g_entity_ragdolls[index], dt);
-        ApplyRagdollToAnimator(g_entity_ragdolls[index], entity->animator);
+    for (int active_index = 0; active_index < g_ragdolls.active_bone_count; active_index++) {
+        int bone_index = g_ragdolls.active_bones[active_index];
+        const RagdollBone& ragdoll_bone = g_ragdolls.bones[bone_index];
+        Vec2 position = Vec2{g_ragdolls.x[bone_index][slot], g_ragdolls.y[bone_index][slot]};
+        float rotation = ragdoll_bone.rotation + GetSegmentAngle(bone_index, slot) - g_ragdolls.start_angle[bone_index][slot];
+        entity->animator.bones[bone_index] = TRS(position + ragdoll_bone.offset, rotation, VEC2_ONE);
     }
+
+    entity->bones = entity->animator.bones;
+    entity->impostor = nullptr;
 }
@@ -17,14 +17,8 @@ inline TowerEntity* CastArcher(Entity* e) {
 static void RenderTower(Entity* e, const Mat3& transform)
 {
     TowerEntity* a = CastArcher(e);
-    BindColor(GetTeamColor(a->team));
-    BindMaterial(g_game.material);
-    DrawMesh(MESH_TOWER_PLAYER_TEMP, transform);
-    BindDepth(-7.0f);
-    BindMaterial(g_game.shadow_material);
-    BindColor(SetAlpha(COLOR_BLACK, 0.1f));
-    DrawMesh(MESH_TOWER_PLAYER_TEMP, transform * Scale(Vec2{1.0f,-0.5f}));
-    BindDepth(0.0f);
+    AddDraw(DRAW_PASS_MAIN, g_game.material, MESH_TOWER_PLAYER_TEMP, transform, GetEntityDepth(e->position), GetTeamColor(a->team), VEC2_ZERO, GetRenderIndex(e));
+    AddShadowDraw(MESH_TOWER_PLAYER_TEMP, transform * Scale(SHADOW_SCALE));
 }
 
 TowerEntity* CreateTower(Team team, const Vec3& position)
@@ -35,6 +29,9 @@ TowerEntity* CreateTower(Team team, const Vec3& position)
 
     TowerEntity* t = static_cast<TowerEntity*>(CreateUnit(UNIT_TYPE_TOWER, team, vtable, position, 0.0f, {GetTeamDirection(team).x, 1.0f}));
     t->health = TOWER_HEALTH;
+    t->max_health = TOWER_HEALTH;
     t->size = TOWER_SIZE;
+    t->is_static = true;
+    AddStaticObstacle(XZ(position), TOWER_SIZE, GetHandle(t));
     return t;
 }
\ No newline at end of file
@@ -0,0 +1,209 @@
+//
+//  Battle TowerZ - Copyright(c) 2025 NoZ Games, LLC
+//
+
+constexpr int MAX_VFX_INSTANCES = 64;
+constexpr int VFX_SPAWN_BUDGET = 16;
+
+// Effects without a pool can not merge, high priority triggers may take them past the budget
+constexpr int MAX_VFX_UNPOOLED_SPAWNS = 32;
+
+// A merged instance is played once more for every factor of this many triggers it stands for, up
+// to the limit, so a volley reads heavier than a single hit without costing one effect per arrow
+constexpr int VFX_MERGE_STRENGTH_STEP = 4;
+constexpr int MAX_VFX_MERGED_PLAYS = 3;
+
+// Fixed pool of live instances for one effect.  The lifetime matches the duration in the .vfx file.
+struct VfxEffect {
+    Vfx** vfx;
+    int pool_size;
+    float lifetime;
+    float merge_radius;
+    int merge_frames;
+};
+
+// Instances spawned this frame stay pending until FlushVfx so triggers merged into them move the
+// effect to their centroid before it plays
+struct VfxInstance {
+    Vec2 position;
+    float spawn_time;
+    u32 spawn_frame;
+    int strength;
+    bool pending;
+};
+
+struct VfxSpawn {
+    Vfx* vfx;
+    Vec2 position;
+};
+
+struct VfxPool {
+    VfxInstance instances[MAX_VFX_INSTANCES];
+    int count;
+};
+
+static const VfxEffect VFX_EFFECTS[] = {
+    { &VFX_ARROW_HIT, 48, 2.0f, 1.0f, 4 },
+    { &VFX_BOW_FIRE, 32, 0.1f, 0.25f, 1 },
+};
+
+constexpr int VFX_EFFECT_COUNT = sizeof(VFX_EFFECTS) / sizeof(VfxEffect);
+
+// Effects are spawned through here instead of straight into the engine.  A trigger close to an
+// instance of the same effect spawned a few frames earlier is folded into that instance, and once
+// the frame's spawn budget is used up only high priority triggers still get a new instance.
+// Nothing is played until FlushVfx runs at the end of the frame.
+struct VfxSystem {
+    VfxPool pools[VFX_EFFECT_COUNT];
+    VfxSpawn unpooled[MAX_VFX_UNPOOLED_SPAWNS];
+    int unpooled_count;
+    float time;
+    int frame_spawns;
+};
+
+static VfxSystem g_vfx = {};
+
+static int GetVfxEffect(Vfx* vfx) {
+    for (int i = 0; i < VFX_EFFECT_COUNT; i++)
+        if (*VFX_EFFECTS[i].vfx == vfx)
+            return i;
+
+    return -1;
+}
+
+static VfxInstance* FindMergeInstance(const VfxEffect& effect, VfxPool& pool, const Vec2& position) {
+    for (int i = 0; i < pool.count; i++) {
+        VfxInstance& instance = pool.instances[i];
+        if (g_game.frame_index - instance.spawn_frame > static_cast<u32>(effect.merge_frames))
+            continue;
+
+        if (LengthSqr(instance.position - position) <= Sqr(effect.merge_radius))
+            return &instance;
+    }
+
+    return nullptr;
+}
+
+static VfxInstance* AllocVfxInstance(VfxPool& pool, const VfxEffect& effect, VfxPriority priority) {
+    if (pool.count < effect.pool_size)
+        return &pool.instances[pool.count++];
+
+    if (priority != VFX_PRIORITY_HIGH)
+        return nullptr;
+
+    // A full pool only gives up its oldest instance to a high priority trigger
+    VfxInstance* oldest = &pool.instances[0];
+    for (int i = 1; i < pool.count; i++)
+        if (pool.instances[i].spawn_time < oldest->spawn_time)
+            oldest = &pool.instances[i];
+
+    return oldest;
+}
+
+void PlayVfx(Vfx* vfx, const Vec2& position, VfxPriority priority) {
+    if (!vfx)
+        return;
+
+    int effect_index = GetVfxEffect(vfx);
+    if (effect_index == -1) {
+        bool over_budget = g_vfx.frame_spawns >= VFX_SPAWN_BUDGET && priority != VFX_PRIORITY_HIGH;
+        if (over_budget || g_vfx.unpooled_count >= MAX_VFX_UNPOOLED_SPAWNS) {
+            g_game.stats.vfx_dropped++;
+            return;
+        }
+
+        g_vfx.unpooled[g_vfx.unpooled_count++] = { vfx, position };
+        g_vfx.frame_spawns++;
+        return;
+    }
+
+    const VfxEffect& effect = VFX_EFFECTS[effect_index];
+    VfxPool& pool = g_vfx.pools[effect_index];
+
+    // An instance that has not played yet is moved to the centroid of the triggers it stands
+    // for, one that already plays just absorbs the trigger
+    VfxInstance* merge = FindMergeInstance(effect, pool, position);
+    if (merge) {
+        if (merge->pending) {
+            merge->strength++;
+            merge->position = merge->position + (position - merge->position) / static_cast<float>(merge->strength);
+        }
+        g_game.stats.vfx_merged++;
+        return;
+    }
+
+    if (g_vfx.frame_spawns >= VFX_SPAWN_BUDGET && priority != VFX_PRIORITY_HIGH) {
+        g_game.stats.vfx_dropped++;
+        return;
+    }
+
+    VfxInstance* instance = AllocVfxInstance(pool, effect, priority);
+    if (!instance) {
+        g_game.stats.vfx_dropped++;
+        return;
+    }
+
+    *instance = {
+        .position = position,
+        .spawn_time = g_vfx.time,
+        .spawn_frame = g_game.frame_index,
+        .strength = 1,
+        .pending = true
+    };
+
+    g_vfx.frame_spawns++;
+}
+
+static int GetVfxPlayCount(int strength) {
+    int plays = 1;
+    for (int remaining = strength; remaining >= VFX_MERGE_STRENGTH_STEP && plays < MAX_VFX_MERGED_PLAYS; remaining /= VFX_MERGE_STRENGTH_STEP)
+        plays++;
+    return plays;
+}
+
+// Plays every instance spawned this frame once all of the frame's triggers are in
+void FlushVfx() {
+    for (int effect_index = 0; effect_index < VFX_EFFECT_COUNT; effect_index++) {
+        Vfx* vfx = *VFX_EFFECTS[effect_index].vfx;
+        VfxPool& pool = g_vfx.pools[effect_index];
+        for (int i = 0; i < pool.count; i++) {
+            VfxInstance& instance = pool.instances[i];
+            if (!instance.pending)
+                continue;
+
+            instance.pending = false;
+            int plays = GetVfxPlayCount(instance.strength);
+            for (int play = 0; play < plays; play++)
+                Play(vfx, instance.position);
+            g_game.stats.vfx_spawned += plays;
+        }
+    }
+
+    for (int i = 0; i < g_vfx.unpooled_count; i++)
+        Play(g_vfx.unpooled[i].vfx, g_vfx.unpooled[i].position);
+
+    g_game.stats.vfx_spawned += g_vfx.unpooled_count;
+    g_vfx.unpooled_count = 0;
+}
+
+// Retires instances whose effect has finished and opens the spawn budget for the next frame
+void UpdateVfx() {
+    g_vfx.time += GetFrameTime();
+    g_vfx.frame_spawns = 0;
+
+    for (int effect_index = 0; effect_index < VFX_EFFECT_COUNT; effect_index++) {
+        const VfxEffect& effect = VFX_EFFECTS[effect_index];
+        VfxPool& pool = g_vfx.pools[effect_index];
+        for (int i = pool.count - 1; i >= 0; i--)
+            if (g_vfx.time - pool.instances[i].spawn_time >= effect.lifetime)
+                pool.instances[i] = pool.instances[--pool.count];
+    }
+}
+
+void ClearVfx() {
+    for (VfxPool& pool : g_vfx.pools)
+        pool.count = 0;
+
+    g_vfx.unpooled_count = 0;
+    g_vfx.frame_spawns = 0;
+}
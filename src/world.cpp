@@ -2,49 +2,697 @@
 //  BattleTowerZ - Copyright(c) 2025 NoZ Games, LLC
 //
 
+// Extra cells built around the view so small pans reuse the cached grid
+constexpr int GRID_MARGIN_CELLS = 4;
+
+// Each team's field is rebuilt this often, the teams take turns so only one is built per update
+constexpr float FLOW_FIELD_INTERVAL = 0.25f;
+
+// Tiles with more enemies start closer, so the field leans toward concentrations
+constexpr float FLOW_FIELD_SOURCE_COST = 4.0f;
+constexpr float FLOW_FIELD_DIAGONAL_COST = 1.41421356f;
+
+// The strength of every living unit spreads over the tiles within INFLUENCE_RADIUS, fading with
+// distance
+constexpr int INFLUENCE_RADIUS = 2;
+constexpr int INFLUENCE_KERNEL_SIZE = INFLUENCE_RADIUS * 2 + 1;
+constexpr float INFLUENCE_DEPTH = -8.8f;
+constexpr float INFLUENCE_DEBUG_MAX = 4.0f;
+
+// Static obstacles are rasterised into a finer distance field over the same area as the tiles.
+// Distances are clamped to OBSTACLE_FIELD_MAX_DISTANCE so an obstacle only touches the cells near it.
+constexpr int MAX_STATIC_OBSTACLES = 128;
+constexpr float OBSTACLE_CELL_SIZE = 0.5f;
+constexpr int OBSTACLE_FIELD_X = static_cast<int>(WORLD_TILES_X * WORLD_TILE_SIZE / OBSTACLE_CELL_SIZE);
+constexpr int OBSTACLE_FIELD_Y = static_cast<int>(WORLD_TILES_Y * WORLD_TILE_SIZE / OBSTACLE_CELL_SIZE);
+constexpr float OBSTACLE_FIELD_MAX_DISTANCE = 4.0f;
+
+// Line of sight marches at least this far per step so grazing an obstacle does not stall it
+constexpr float OBSTACLE_LOS_MIN_STEP = OBSTACLE_CELL_SIZE * 0.5f;
+
+static_assert(WORLD_TILES_X * WORLD_TILES_Y == WORLD_MAX_TILES, "world tiles must fill WORLD_MAX_TILES");
+
+struct FlowField {
+    Vec2 directions[WORLD_MAX_TILES];
+    bool valid;
+};
+
+struct StaticObstacle {
+    Vec2 position;
+    float radius;
+    EntityHandle entity;
+};
+
 struct WorldSystem {
+    Mesh* grid_mesh;
+    int grid_min_x;
+    int grid_min_y;
+    int grid_max_x;
+    int grid_max_y;
+    float grid_line_thickness;
+
+    // Flow fields toward the enemies of each team on a coarse tile grid over the battle area.
+    // Tiles whose center is inside a static obstacle are blocked and never crossed.
+    FlowField flow_fields[TEAM_COUNT];
+    bool blocked[WORLD_MAX_TILES];
+    int enemy_counts[WORLD_MAX_TILES];
+    float costs[WORLD_MAX_TILES];
+    int heap[WORLD_MAX_TILES * 8];
+    float heap_costs[WORLD_MAX_TILES * 8];
+    int heap_count;
+    float flow_field_timer;
+    int flow_field_team;
+
+    // Influence and density of each team per tile, rebuilt every tick.  Units only add their
+    // strength to their own tile, the kernel is applied once per tile afterwards.
+    float influence[TEAM_COUNT][WORLD_MAX_TILES];
+    float density[TEAM_COUNT][WORLD_MAX_TILES];
+    float strength[TEAM_COUNT][WORLD_MAX_TILES];
+
+    // Living units of each team by tile, built in the same pass so target and neighbour queries
+    // only visit the tiles around the asking unit.  Units off the grid are kept on the nearest tile.
+    // Static units are not indexed, they are found through the obstacle list.
+    int unit_heads[TEAM_COUNT][WORLD_MAX_TILES];
+    int unit_next[MAX_UNITS];
+    EntityHandle unit_handles[MAX_UNITS];
+    int unit_count;
+    float influence_kernel[INFLUENCE_KERNEL_SIZE][INFLUENCE_KERNEL_SIZE];
+    float debug_balance[WORLD_MAX_TILES];
+    Mesh* debug_mesh;
+
+    // Things that never move, kept out of the per-tick unit scans and read through the field instead
+    StaticObstacle obstacles[MAX_STATIC_OBSTACLES];
+    int obstacle_count;
+    float obstacle_field[OBSTACLE_FIELD_X * OBSTACLE_FIELD_Y];
 };
 
 static WorldSystem g_world = {};
 
+static void AddGridQuad(MeshBuilder* builder, int quad_index, const Vec2& min, const Vec2& max, const Vec2& uv) {
+    u16 base = static_cast<u16>(quad_index * 4);
+    AddVertex(builder, Vec2{min.x, min.y}, uv);
+    AddVertex(builder, Vec2{max.x, min.y}, uv);
+    AddVertex(builder, Vec2{max.x, max.y}, uv);
+    AddVertex(builder, Vec2{min.x, max.y}, uv);
+    AddTriangle(builder, base + 0, base + 1, base + 2);
+    AddTriangle(builder, base + 0, base + 2, base + 3);
+}
+
+// All grid lines over a cell aligned region are built into one mesh, relative to the region
+// minimum.  The mesh is only rebuilt when the view leaves the region or the zoom changes the
+// line thickness.
+static void UpdateGridMesh(const Bounds2& bounds, float line_thickness) {
+    int min_x = static_cast<int>(floorf(bounds.min.x));
+    int min_y = static_cast<int>(floorf(bounds.min.y));
+    int max_x = static_cast<int>(ceilf(bounds.max.x));
+    int max_y = static_cast<int>(ceilf(bounds.max.y));
+    if (g_world.grid_mesh &&
+        line_thickness == g_world.grid_line_thickness &&
+        min_x >= g_world.grid_min_x &&
+        min_y >= g_world.grid_min_y &&
+        max_x <= g_world.grid_max_x &&
+        max_y <= g_world.grid_max_y)
+        return;
+
+    if (g_world.grid_mesh)
+        Free(g_world.grid_mesh);
+
+    g_world.grid_min_x = min_x - GRID_MARGIN_CELLS;
+    g_world.grid_min_y = min_y - GRID_MARGIN_CELLS;
+    g_world.grid_max_x = max_x + GRID_MARGIN_CELLS;
+    g_world.grid_max_y = max_y + GRID_MARGIN_CELLS;
+    g_world.grid_line_thickness = line_thickness;
+
+    float width = static_cast<float>(g_world.grid_max_x - g_world.grid_min_x);
+    float height = static_cast<float>(g_world.grid_max_y - g_world.grid_min_y);
+    int line_count = (g_world.grid_max_x - g_world.grid_min_x + 1) + (g_world.grid_max_y - g_world.grid_min_y + 1);
+    Vec2 uv = ColorUV(7,0);
+
+    PushScratch();
+    MeshBuilder* builder = CreateMeshBuilder(ALLOCATOR_SCRATCH, line_count * 4, line_count * 6);
+    int quad_index = 0;
+    for (int x = 0; x <= g_world.grid_max_x - g_world.grid_min_x; x++)
+        AddGridQuad(builder, quad_index++, Vec2{x - line_thickness, 0.0f}, Vec2{x + line_thickness, height}, uv);
+    for (int y = 0; y <= g_world.grid_max_y - g_world.grid_min_y; y++)
+        AddGridQuad(builder, quad_index++, Vec2{0.0f, y - line_thickness}, Vec2{width, y + line_thickness}, uv);
+    g_world.grid_mesh = CreateMesh(ALLOCATOR_DEFAULT, builder, NAME_NONE, true);
+    PopScratch();
+}
+
 void DrawGrid(Camera* camera) {
     Bounds2 bounds = GetBounds(camera);
-    const float left = bounds.min.x;
-    const float right = bounds.max.x;
-    const float bottom = bounds.min.y;
-    const float top = bounds.max.y;
 
     // Calculate line thickness based on world-to-screen scale
     // Use world units for consistent visual thickness
     Vec2Int screen_size = GetScreenSize();
-    float world_height = top - bottom;
+    float world_height = bounds.max.y - bounds.min.y;
     float pixels_per_world_unit = screen_size.y / world_height;
     float line_thickness = 1.0f / pixels_per_world_unit;
 
+    UpdateGridMesh(bounds, line_thickness);
+
     BindDepth(-39.0f);
     BindColor(GRID_COLOR);
     BindMaterial(g_game.material);
+    DrawMesh(g_world.grid_mesh, Translate(Vec2{static_cast<float>(g_world.grid_min_x), static_cast<float>(g_world.grid_min_y)}));
+    BindDepth(0.0f);
+}
+
+static int GetWorldTile(const Vec2& position) {
+    Vec2 cell = (position - WORLD_TILES_MIN) / WORLD_TILE_SIZE;
+    int tile_x = static_cast<int>(floorf(cell.x));
+    int tile_y = static_cast<int>(floorf(cell.y));
+    if (tile_x < 0 || tile_x >= WORLD_TILES_X || tile_y < 0 || tile_y >= WORLD_TILES_Y)
+        return -1;
+
+    return tile_y * WORLD_TILES_X + tile_x;
+}
+
+static int GetClampedWorldTile(const Vec2& position) {
+    Vec2 cell = (position - WORLD_TILES_MIN) / WORLD_TILE_SIZE;
+    int tile_x = Clamp(static_cast<int>(floorf(cell.x)), 0, WORLD_TILES_X - 1);
+    int tile_y = Clamp(static_cast<int>(floorf(cell.y)), 0, WORLD_TILES_Y - 1);
+    return tile_y * WORLD_TILES_X + tile_x;
+}
+
+static void PushFlowTile(int tile, float cost) {
+    int index = g_world.heap_count++;
+    while (index > 0) {
+        int parent = (index - 1) / 2;
+        if (g_world.heap_costs[parent] <= cost)
+            break;
 
-    const float start_x = floorf(left);
-    for (float x = start_x; x <= right + 1.0f; x += 1.0f) {
-        Vec2 line_center = { x, (top + bottom) * 0.5f };
-        Vec2 line_scale = { line_thickness, (top - bottom) * 0.5f };
-        DrawMesh(g_game.line_mesh, TRS(line_center, 0, line_scale));
+        g_world.heap[index] = g_world.heap[parent];
+        g_world.heap_costs[index] = g_world.heap_costs[parent];
+        index = parent;
     }
 
-    const float start_y = floorf(bottom);
-    for (float y = start_y; y <= top + 1.0f; y += 1.0f) {
-        Vec2 line_center = { (left + right) * 0.5f, y };
-        Vec2 line_scale = { (right - left) * 0.5f, line_thickness };
-        DrawMesh(g_game.line_mesh, TRS(line_center, 0, line_scale));
+    g_world.heap[index] = tile;
+    g_world.heap_costs[index] = cost;
+}
+
+static int PopFlowTile(float* cost) {
+    int tile = g_world.heap[0];
+    *cost = g_world.heap_costs[0];
+
+    int last = --g_world.heap_count;
+    int last_tile = g_world.heap[last];
+    float last_cost = g_world.heap_costs[last];
+    int index = 0;
+    for (;;) {
+        int child = index * 2 + 1;
+        if (child >= last)
+            break;
+
+        if (child + 1 < last && g_world.heap_costs[child + 1] < g_world.heap_costs[child])
+            child++;
+
+        if (last_cost <= g_world.heap_costs[child])
+            break;
+
+        g_world.heap[index] = g_world.heap[child];
+        g_world.heap_costs[index] = g_world.heap_costs[child];
+        index = child;
+    }
+
+    g_world.heap[index] = last_tile;
+    g_world.heap_costs[index] = last_cost;
+    return tile;
+}
+
+static bool CountEnemyTile(u32, void* item, void* user_data) {
+    Entity* e = static_cast<Entity*>(item);
+    Team team = *static_cast<Team*>(user_data);
+    if (e->type != ENTITY_TYPE_UNIT)
+        return true;
+
+    UnitEntity* u = static_cast<UnitEntity*>(e);
+    if (u->team == team || u->state == UNIT_STATE_DEAD || u->health <= 0.0f)
+        return true;
+
+    int tile = GetWorldTile(XZ(u->position));
+    if (tile != -1)
+        g_world.enemy_counts[tile]++;
+
+    return true;
+}
+
+static const int FLOW_NEIGHBOR_X[] = { 1, -1, 0, 0, 1, 1, -1, -1 };
+static const int FLOW_NEIGHBOR_Y[] = { 0, 0, 1, -1, 1, -1, 1, -1 };
+
+// Neighbour n of the tile, or -1 when it is off the grid or a diagonal step would cut the corner
+// of a blocked tile
+static int GetFlowNeighbor(int tile_x, int tile_y, int n) {
+    int x = tile_x + FLOW_NEIGHBOR_X[n];
+    int y = tile_y + FLOW_NEIGHBOR_Y[n];
+    if (x < 0 || x >= WORLD_TILES_X || y < 0 || y >= WORLD_TILES_Y)
+        return -1;
+
+    if (n >= 4 && (g_world.blocked[tile_y * WORLD_TILES_X + x] || g_world.blocked[y * WORLD_TILES_X + tile_x]))
+        return -1;
+
+    return y * WORLD_TILES_X + x;
+}
+
+// Multi-source Dijkstra from every tile holding enemies, then each tile points at its cheapest
+// neighbour.  The heap allows duplicate entries instead of a decrease-key, stale ones are skipped.
+// The enemy counts hold the number of enemies of the team on every tile.  A blocked tile holding
+// enemies, such as a tower, is still a source but the search never expands into blocked tiles.
+//
+// The field is always rebuilt whole.  Every source moves between builds, so a repair from the
+// changed tiles would reach most of the grid anyway, and a full build only visits the eight
+// neighbours of each tile once, a few times a second.
+void BuildFlowField(Team team, const int* enemy_counts) {
+    FlowField& field = g_world.flow_fields[team];
+    g_world.heap_count = 0;
+
+    bool has_sources = false;
+    for (int tile = 0; tile < WORLD_MAX_TILES; tile++) {
+        g_world.costs[tile] = F32_MAX;
+        if (enemy_counts[tile] == 0)
+            continue;
+
+        g_world.costs[tile] = FLOW_FIELD_SOURCE_COST / static_cast<float>(enemy_counts[tile]);
+        PushFlowTile(tile, g_world.costs[tile]);
+        has_sources = true;
+    }
+
+    field.valid = has_sources;
+    if (!has_sources)
+        return;
+
+    while (g_world.heap_count > 0) {
+        float cost;
+        int tile = PopFlowTile(&cost);
+        if (cost > g_world.costs[tile])
+            continue;
+
+        int tile_x = tile % WORLD_TILES_X;
+        int tile_y = tile / WORLD_TILES_X;
+        for (int n = 0; n < 8; n++) {
+            int neighbor = GetFlowNeighbor(tile_x, tile_y, n);
+            if (neighbor == -1 || g_world.blocked[neighbor])
+                continue;
+
+            float neighbor_cost = cost + (n < 4 ? 1.0f : FLOW_FIELD_DIAGONAL_COST);
+            if (neighbor_cost >= g_world.costs[neighbor] || g_world.heap_count >= WORLD_MAX_TILES * 8)
+                continue;
+
+            g_world.costs[neighbor] = neighbor_cost;
+            PushFlowTile(neighbor, neighbor_cost);
+        }
+    }
+
+    for (int tile = 0; tile < WORLD_MAX_TILES; tile++) {
+        int tile_x = tile % WORLD_TILES_X;
+        int tile_y = tile / WORLD_TILES_X;
+        float best_cost = g_world.costs[tile];
+        int best_neighbor = -1;
+        for (int n = 0; n < 8; n++) {
+            int neighbor = GetFlowNeighbor(tile_x, tile_y, n);
+            if (neighbor == -1)
+                continue;
+
+            float neighbor_cost = g_world.costs[neighbor];
+            if (neighbor_cost < best_cost) {
+                best_cost = neighbor_cost;
+                best_neighbor = n;
+            }
+        }
+
+        field.directions[tile] = best_neighbor == -1
+            ? VEC2_ZERO
+            : Normalize(Vec2{static_cast<float>(FLOW_NEIGHBOR_X[best_neighbor]), static_cast<float>(FLOW_NEIGHBOR_Y[best_neighbor])});
+    }
+}
+
+// Rebuilds one team's flow field every FLOW_FIELD_INTERVAL / TEAM_COUNT seconds.  The cost is
+// one pass over the units to bin the enemies plus a sweep over the tiles, however many units
+// read the field.
+void UpdateFlowFields(float dt) {
+    g_world.flow_field_timer -= dt;
+    if (g_world.flow_field_timer > 0.0f)
+        return;
+
+    g_world.flow_field_timer = FLOW_FIELD_INTERVAL / static_cast<float>(TEAM_COUNT);
+
+    Team team = static_cast<Team>(g_world.flow_field_team);
+    g_world.flow_field_team = (g_world.flow_field_team + 1) % TEAM_COUNT;
+
+    for (int& count : g_world.enemy_counts)
+        count = 0;
+
+    Enumerate(g_game.entity_allocator, CountEnemyTile, &team);
+    BuildFlowField(team, g_world.enemy_counts);
+}
+
+// Direction toward the nearest enemy concentration, zero when there is no field at the position
+Vec2 SampleFlowField(Team team, const Vec2& position) {
+    if (team < 0 || team >= TEAM_COUNT || !g_world.flow_fields[team].valid)
+        return VEC2_ZERO;
+
+    int tile = GetWorldTile(position);
+    if (tile == -1)
+        return VEC2_ZERO;
+
+    return g_world.flow_fields[team].directions[tile];
+}
+
+void ClearFlowFields() {
+    for (FlowField& field : g_world.flow_fields)
+        field.valid = false;
+
+    g_world.flow_field_timer = 0.0f;
+    g_world.flow_field_team = 0;
+}
+
+static bool ScatterUnit(u32, void* item, void*) {
+    Entity* e = static_cast<Entity*>(item);
+    if (e->type != ENTITY_TYPE_UNIT)
+        return true;
+
+    UnitEntity* u = static_cast<UnitEntity*>(e);
+    if (u->team < 0 || u->team >= TEAM_COUNT || u->state == UNIT_STATE_DEAD || u->health <= 0.0f)
+        return true;
+
+    if (!u->is_static && g_world.unit_count < MAX_UNITS) {
+        int index = g_world.unit_count++;
+        int tile = GetClampedWorldTile(XZ(u->position));
+        g_world.unit_handles[index] = GetHandle(u);
+        g_world.unit_next[index] = g_world.unit_heads[u->team][tile];
+        g_world.unit_heads[u->team][tile] = index;
     }
 
+    int tile = GetWorldTile(XZ(u->position));
+    if (tile == -1)
+        return true;
+
+    g_world.strength[u->team][tile] += u->max_health > 0.0f ? u->health / u->max_health : 1.0f;
+    g_world.density[u->team][tile] += 1.0f;
+    return true;
+}
+
+// Spreads the strength gathered on each tile over its neighbours, the cost depends on the number of
+// occupied tiles and not on the number of units
+static void SpreadInfluence(Team team) {
+    const float* strength = g_world.strength[team];
+    float* influence = g_world.influence[team];
+    for (int tile = 0; tile < WORLD_MAX_TILES; tile++) {
+        if (strength[tile] <= 0.0f)
+            continue;
+
+        int tile_x = tile % WORLD_TILES_X;
+        int tile_y = tile / WORLD_TILES_X;
+        int min_x = Max(tile_x - INFLUENCE_RADIUS, 0);
+        int max_x = Min(tile_x + INFLUENCE_RADIUS, WORLD_TILES_X - 1);
+        int min_y = Max(tile_y - INFLUENCE_RADIUS, 0);
+        int max_y = Min(tile_y + INFLUENCE_RADIUS, WORLD_TILES_Y - 1);
+        for (int y = min_y; y <= max_y; y++) {
+            float* row = influence + y * WORLD_TILES_X;
+            const float* kernel = g_world.influence_kernel[y - tile_y + INFLUENCE_RADIUS];
+            for (int x = min_x; x <= max_x; x++)
+                row[x] += strength[tile] * kernel[x - tile_x + INFLUENCE_RADIUS];
+        }
+    }
+}
+
+void UpdateInfluenceMaps() {
+    for (int team = 0; team < TEAM_COUNT; team++) {
+        for (int tile = 0; tile < WORLD_MAX_TILES; tile++) {
+            g_world.influence[team][tile] = 0.0f;
+            g_world.density[team][tile] = 0.0f;
+            g_world.strength[team][tile] = 0.0f;
+            g_world.unit_heads[team][tile] = -1;
+        }
+    }
+
+    g_world.unit_count = 0;
+    Enumerate(g_game.entity_allocator, ScatterUnit);
+
+    for (int team = 0; team < TEAM_COUNT; team++)
+        SpreadInfluence(static_cast<Team>(team));
+}
+
+// Units indexed on the tile that are still alive, the index is a tick old so freed units are skipped
+static bool EnumerateTileUnits(Team team, int tile, bool (*callback)(UnitEntity* unit, void* user_data), void* user_data) {
+    for (int index = g_world.unit_heads[team][tile]; index != -1; index = g_world.unit_next[index]) {
+        UnitEntity* u = GetUnit(g_world.unit_handles[index]);
+        if (!u || u->health <= 0.0f)
+            continue;
+
+        if (!callback(u, user_data))
+            return false;
+    }
+
+    return true;
+}
+
+// Visits the units of the team on the square ring of tiles around the tile of the position, ring 0
+// being the tile itself.  Returns false once the ring lies completely outside the grid.
+bool EnumerateUnitsInRing(Team team, const Vec2& position, int ring, bool (*callback)(UnitEntity* unit, void* user_data), void* user_data) {
+    if (team < 0 || team >= TEAM_COUNT)
+        return false;
+
+    int tile = GetClampedWorldTile(position);
+    int tile_x = tile % WORLD_TILES_X;
+    int tile_y = tile / WORLD_TILES_X;
+    int reach = Max(Max(tile_x, WORLD_TILES_X - 1 - tile_x), Max(tile_y, WORLD_TILES_Y - 1 - tile_y));
+    if (ring > reach)
+        return false;
+
+    for (int y = Max(tile_y - ring, 0); y <= Min(tile_y + ring, WORLD_TILES_Y - 1); y++) {
+        bool edge_row = y == tile_y - ring || y == tile_y + ring;
+        int step = edge_row || ring == 0 ? 1 : ring * 2;
+        for (int x = tile_x - ring; x <= tile_x + ring; x += step) {
+            if (x < 0 || x >= WORLD_TILES_X)
+                continue;
+
+            if (!EnumerateTileUnits(team, y * WORLD_TILES_X + x, callback, user_data))
+                return true;
+        }
+    }
+
+    return true;
+}
+
+// Enemy influence at the position, how dangerous it is for the team to be there
+float GetThreat(Team team, const Vec2& position) {
+    int tile = GetWorldTile(position);
+    if (tile == -1 || team < 0 || team >= TEAM_COUNT)
+        return 0.0f;
+
+    float threat = 0.0f;
+    for (int other = 0; other < TEAM_COUNT; other++)
+        if (other != team)
+            threat += g_world.influence[other][tile];
+
+    return threat;
+}
+
+// Own influence minus enemy influence, positive where the team has the upper hand
+float GetInfluenceBalance(Team team, const Vec2& position) {
+    int tile = GetWorldTile(position);
+    if (tile == -1 || team < 0 || team >= TEAM_COUNT)
+        return 0.0f;
+
+    return g_world.influence[team][tile] - GetThreat(team, position);
+}
+
+float GetDensity(Team team, const Vec2& position) {
+    int tile = GetWorldTile(position);
+    if (tile == -1 || team < 0 || team >= TEAM_COUNT)
+        return 0.0f;
+
+    return g_world.density[team][tile];
+}
+
+// Copies the red team's balance for the heatmap while the simulation is idle
+void CommitInfluenceMaps() {
+    if (!g_game.show_influence)
+        return;
+
+    for (int tile = 0; tile < WORLD_MAX_TILES; tile++)
+        g_world.debug_balance[tile] = g_world.influence[TEAM_RED][tile] - g_world.influence[TEAM_BLUE][tile];
+}
+
+// Each tile is drawn as a square in the color of the stronger team, sized by how much stronger
+void DrawInfluenceMaps() {
+    if (!g_game.show_influence)
+        return;
+
+    if (g_world.debug_mesh) {
+        Free(g_world.debug_mesh);
+        g_world.debug_mesh = nullptr;
+    }
+
+    PushScratch();
+    MeshBuilder* builder = CreateMeshBuilder(ALLOCATOR_SCRATCH, WORLD_MAX_TILES * 4, WORLD_MAX_TILES * 6);
+    int quad_index = 0;
+    for (int tile = 0; tile < WORLD_MAX_TILES; tile++) {
+        float balance = g_world.debug_balance[tile];
+        float size = Min(Abs(balance) / INFLUENCE_DEBUG_MAX, 1.0f) * WORLD_TILE_SIZE * 0.5f;
+        if (size <= 0.0f)
+            continue;
+
+        Vec2 center = WORLD_TILES_MIN + Vec2{
+            (tile % WORLD_TILES_X + 0.5f) * WORLD_TILE_SIZE,
+            (tile / WORLD_TILES_X + 0.5f) * WORLD_TILE_SIZE};
+        Team team = balance > 0.0f ? TEAM_RED : TEAM_BLUE;
+        AddGridQuad(builder, quad_index++, center - Vec2{size, size}, center + Vec2{size, size}, ColorUV(6,1) + GetTeamColorOffset(team));
+    }
+
+    if (quad_index > 0)
+        g_world.debug_mesh = CreateMesh(ALLOCATOR_DEFAULT, builder, NAME_NONE, true);
+    PopScratch();
+
+    if (!g_world.debug_mesh)
+        return;
+
+    BindDepth(INFLUENCE_DEPTH);
+    BindColor(SetAlpha(COLOR_WHITE, 0.5f));
+    BindMaterial(g_game.material);
+    DrawMesh(g_world.debug_mesh, Translate(VEC2_ZERO));
     BindDepth(0.0f);
 }
 
+void AddStaticObstacle(const Vec2& position, float radius, const EntityHandle& entity) {
+    if (g_world.obstacle_count >= MAX_STATIC_OBSTACLES)
+        return;
+
+    g_world.obstacles[g_world.obstacle_count++] = { position, radius, entity };
+}
+
+// Drops the obstacles of a destroyed entity and rebuilds the field without them
+void RemoveStaticObstacle(const EntityHandle& entity) {
+    int count = g_world.obstacle_count;
+    for (int i = g_world.obstacle_count - 1; i >= 0; i--)
+        if (g_world.obstacles[i].entity.index == entity.index && g_world.obstacles[i].entity.generation == entity.generation)
+            g_world.obstacles[i] = g_world.obstacles[--g_world.obstacle_count];
+
+    if (count != g_world.obstacle_count)
+        BuildObstacleField();
+}
+
+// Visits the living static units of the team that registered an obstacle
+void EnumerateStaticUnits(Team team, bool (*callback)(UnitEntity* unit, void* user_data), void* user_data) {
+    for (int i = 0; i < g_world.obstacle_count; i++) {
+        UnitEntity* u = GetUnit(g_world.obstacles[i].entity);
+        if (!u || u->team != team || u->health <= 0.0f)
+            continue;
+
+        if (!callback(u, user_data))
+            return;
+    }
+}
+
+void ClearStaticObstacles() {
+    g_world.obstacle_count = 0;
+    BuildObstacleField();
+}
+
+// Each obstacle writes the signed distance to its edge into the cells within reach of it, keeping
+// the smallest distance per cell.  The flow field tiles are blocked from the finished field.  Only
+// done when the set of obstacles changes, never per tick.
+void BuildObstacleField() {
+    for (float& distance : g_world.obstacle_field)
+        distance = OBSTACLE_FIELD_MAX_DISTANCE;
+
+    for (int i = 0; i < g_world.obstacle_count; i++) {
+        const StaticObstacle& obstacle = g_world.obstacles[i];
+        float reach = obstacle.radius + OBSTACLE_FIELD_MAX_DISTANCE;
+        Vec2 min = (obstacle.position - WORLD_TILES_MIN - Vec2{reach, reach}) / OBSTACLE_CELL_SIZE;
+        Vec2 max = (obstacle.position - WORLD_TILES_MIN + Vec2{reach, reach}) / OBSTACLE_CELL_SIZE;
+        int min_x = Max(static_cast<int>(floorf(min.x)), 0);
+        int min_y = Max(static_cast<int>(floorf(min.y)), 0);
+        int max_x = Min(static_cast<int>(ceilf(max.x)), OBSTACLE_FIELD_X - 1);
+        int max_y = Min(static_cast<int>(ceilf(max.y)), OBSTACLE_FIELD_Y - 1);
+        for (int y = min_y; y <= max_y; y++) {
+            float* row = g_world.obstacle_field + y * OBSTACLE_FIELD_X;
+            for (int x = min_x; x <= max_x; x++) {
+                Vec2 center = WORLD_TILES_MIN + Vec2{(x + 0.5f) * OBSTACLE_CELL_SIZE, (y + 0.5f) * OBSTACLE_CELL_SIZE};
+                row[x] = Min(row[x], Length(center - obstacle.position) - obstacle.radius);
+            }
+        }
+    }
+
+    for (int tile = 0; tile < WORLD_MAX_TILES; tile++) {
+        Vec2 center = WORLD_TILES_MIN + Vec2{(tile % WORLD_TILES_X + 0.5f) * WORLD_TILE_SIZE, (tile / WORLD_TILES_X + 0.5f) * WORLD_TILE_SIZE};
+        g_world.blocked[tile] = GetObstacleDistance(center) < 0.0f;
+    }
+}
+
+static float GetObstacleCell(int x, int y) {
+    x = Clamp(x, 0, OBSTACLE_FIELD_X - 1);
+    y = Clamp(y, 0, OBSTACLE_FIELD_Y - 1);
+    return g_world.obstacle_field[y * OBSTACLE_FIELD_X + x];
+}
+
+// Distance to the nearest static obstacle edge, negative inside one, bilinear between cell centers
+float GetObstacleDistance(const Vec2& position) {
+    if (g_world.obstacle_count == 0)
+        return OBSTACLE_FIELD_MAX_DISTANCE;
+
+    Vec2 cell = (position - WORLD_TILES_MIN) / OBSTACLE_CELL_SIZE - Vec2{0.5f, 0.5f};
+    if (cell.x < -1.0f || cell.y < -1.0f || cell.x > OBSTACLE_FIELD_X || cell.y > OBSTACLE_FIELD_Y)
+        return OBSTACLE_FIELD_MAX_DISTANCE;
+
+    int x = static_cast<int>(floorf(cell.x));
+    int y = static_cast<int>(floorf(cell.y));
+    float tx = cell.x - x;
+    float ty = cell.y - y;
+    float bottom = GetObstacleCell(x, y) + (GetObstacleCell(x + 1, y) - GetObstacleCell(x, y)) * tx;
+    float top = GetObstacleCell(x, y + 1) + (GetObstacleCell(x + 1, y + 1) - GetObstacleCell(x, y + 1)) * tx;
+    return bottom + (top - bottom) * ty;
+}
+
+// Direction away from the nearest obstacle, zero where there is none within reach
+Vec2 GetObstacleNormal(const Vec2& position) {
+    if (g_world.obstacle_count == 0)
+        return VEC2_ZERO;
+
+    Vec2 gradient = {
+        GetObstacleDistance(position + Vec2{OBSTACLE_CELL_SIZE, 0.0f}) - GetObstacleDistance(position - Vec2{OBSTACLE_CELL_SIZE, 0.0f}),
+        GetObstacleDistance(position + Vec2{0.0f, OBSTACLE_CELL_SIZE}) - GetObstacleDistance(position - Vec2{0.0f, OBSTACLE_CELL_SIZE})};
+    if (LengthSqr(gradient) <= 0.0f)
+        return VEC2_ZERO;
+
+    return Normalize(gradient);
+}
+
+// Sphere traces the segment through the field, every step can safely advance by the distance to
+// the nearest obstacle.  The clearance is how close the line may pass to an obstacle.
+bool HasLineOfSight(const Vec2& from, const Vec2& to, float clearance) {
+    if (g_world.obstacle_count == 0)
+        return true;
+
+    Vec2 delta = to - from;
+    float length = Length(delta);
+    if (length <= 0.0f)
+        return GetObstacleDistance(from) >= clearance;
+
+    Vec2 direction = delta / length;
+    float t = 0.0f;
+    for (;;) {
+        float distance = GetObstacleDistance(from + direction * Min(t, length)) - clearance;
+        if (distance < 0.0f)
+            return false;
+
+        if (t >= length)
+            return true;
+
+        t += Max(distance, OBSTACLE_LOS_MIN_STEP);
+    }
+}
+
 void DrawWorld(Camera* camera) {
     DrawGrid(camera);
 }
 
 void InitWorld() {
+    for (int y = 0; y < INFLUENCE_KERNEL_SIZE; y++) {
+        for (int x = 0; x < INFLUENCE_KERNEL_SIZE; x++) {
+            float distance = Length(Vec2{static_cast<float>(x - INFLUENCE_RADIUS), static_cast<float>(y - INFLUENCE_RADIUS)});
+            g_world.influence_kernel[y][x] = Max(0.0f, 1.0f - distance / (INFLUENCE_RADIUS + 1));
+        }
+    }
 }
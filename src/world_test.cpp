@@ -0,0 +1,147 @@
+//
+//  Battle TowerZ - Copyright(c) 2025 NoZ Games, LLC
+//
+
+#include "test.h"
+
+constexpr float WORLD_TEST_TOLERANCE = 0.0001f;
+constexpr float WORLD_TEST_DIAGONAL = 0.70710678f;
+
+static int g_world_test_counts[WORLD_MAX_TILES] = {};
+
+static Vec2 GetTestTileCenter(int x, int y) {
+    return WORLD_TILES_MIN + Vec2{(x + 0.5f) * WORLD_TILE_SIZE, (y + 0.5f) * WORLD_TILE_SIZE};
+}
+
+static void SetTestEnemies(int x, int y, int count) {
+    g_world_test_counts[y * WORLD_TILES_X + x] = count;
+}
+
+static void BeginFlowFieldTest() {
+    ClearStaticObstacles();
+    for (int& count : g_world_test_counts)
+        count = 0;
+}
+
+static bool IsNear(const Vec2& a, const Vec2& b) {
+    return Abs(a.x - b.x) <= WORLD_TEST_TOLERANCE && Abs(a.y - b.y) <= WORLD_TEST_TOLERANCE;
+}
+
+TEST(FlowFieldWithoutEnemiesIsZero) {
+    BeginFlowFieldTest();
+    BuildFlowField(TEAM_RED, g_world_test_counts);
+
+    EXPECT(IsNear(SampleFlowField(TEAM_RED, GetTestTileCenter(4, 4)), VEC2_ZERO));
+}
+
+// Neighbours point straight at the enemy tile, diagonal ones with unit length
+TEST(FlowFieldPointsAtEnemyTile) {
+    BeginFlowFieldTest();
+    SetTestEnemies(10, 10, 1);
+    BuildFlowField(TEAM_RED, g_world_test_counts);
+
+    EXPECT(IsNear(SampleFlowField(TEAM_RED, GetTestTileCenter(10, 10)), VEC2_ZERO));
+    EXPECT(IsNear(SampleFlowField(TEAM_RED, GetTestTileCenter(11, 10)), Vec2{-1.0f, 0.0f}));
+    EXPECT(IsNear(SampleFlowField(TEAM_RED, GetTestTileCenter(10, 9)), Vec2{0.0f, 1.0f}));
+    EXPECT(IsNear(SampleFlowField(TEAM_RED, GetTestTileCenter(9, 11)), Vec2{WORLD_TEST_DIAGONAL, -WORLD_TEST_DIAGONAL}));
+    EXPECT(IsNear(SampleFlowField(TEAM_RED, GetTestTileCenter(20, 10)), Vec2{-1.0f, 0.0f}));
+}
+
+// Halfway between a lone enemy and a group the field leads to the group
+TEST(FlowFieldPrefersEnemyConcentration) {
+    BeginFlowFieldTest();
+    SetTestEnemies(10, 16, 1);
+    SetTestEnemies(20, 16, 4);
+    BuildFlowField(TEAM_RED, g_world_test_counts);
+
+    EXPECT(IsNear(SampleFlowField(TEAM_RED, GetTestTileCenter(15, 16)), Vec2{1.0f, 0.0f}));
+    EXPECT(IsNear(SampleFlowField(TEAM_RED, GetTestTileCenter(11, 16)), Vec2{-1.0f, 0.0f}));
+}
+
+TEST(FlowFieldIsPerTeam) {
+    BeginFlowFieldTest();
+    ClearFlowFields();
+    SetTestEnemies(10, 10, 1);
+    BuildFlowField(TEAM_RED, g_world_test_counts);
+
+    EXPECT(IsNear(SampleFlowField(TEAM_BLUE, GetTestTileCenter(11, 10)), VEC2_ZERO));
+    EXPECT(IsNear(SampleFlowField(TEAM_RED, WORLD_TILES_MIN - Vec2{1.0f, 1.0f}), VEC2_ZERO));
+}
+
+// One obstacle of radius 2 at the origin, its distance is only exact at cell centers
+constexpr float OBSTACLE_TEST_RADIUS = 2.0f;
+constexpr float OBSTACLE_TEST_TOLERANCE = 0.1f;
+constexpr EntityHandle OBSTACLE_TEST_ENTITY = { 1, 1 };
+
+static void BeginObstacleTest() {
+    ClearStaticObstacles();
+    AddStaticObstacle(VEC2_ZERO, OBSTACLE_TEST_RADIUS, OBSTACLE_TEST_ENTITY);
+    BuildObstacleField();
+}
+
+TEST(ObstacleFieldIsEmptyWithoutObstacles) {
+    ClearStaticObstacles();
+
+    EXPECT(GetObstacleDistance(VEC2_ZERO) > 0.0f);
+    EXPECT(IsNear(GetObstacleNormal(VEC2_ZERO), VEC2_ZERO));
+    EXPECT(HasLineOfSight(Vec2{-6.0f, 0.0f}, Vec2{6.0f, 0.0f}));
+}
+
+TEST(ObstacleDistanceIsSigned) {
+    BeginObstacleTest();
+
+    EXPECT_NEAR(GetObstacleDistance(Vec2{3.0f, 0.0f}), 1.0f, OBSTACLE_TEST_TOLERANCE);
+    EXPECT_NEAR(GetObstacleDistance(Vec2{0.0f, -3.5f}), 1.5f, OBSTACLE_TEST_TOLERANCE);
+    EXPECT(GetObstacleDistance(Vec2{0.5f, 0.5f}) < 0.0f);
+}
+
+TEST(ObstacleNormalPointsAway) {
+    BeginObstacleTest();
+
+    Vec2 right = GetObstacleNormal(Vec2{3.0f, 0.0f});
+    Vec2 down = GetObstacleNormal(Vec2{0.0f, -3.0f});
+    EXPECT(right.x > 0.99f && Abs(right.y) < OBSTACLE_TEST_TOLERANCE);
+    EXPECT(down.y < -0.99f && Abs(down.x) < OBSTACLE_TEST_TOLERANCE);
+}
+
+TEST(ObstacleBlocksLineOfSight) {
+    BeginObstacleTest();
+
+    EXPECT(!HasLineOfSight(Vec2{-6.0f, 0.0f}, Vec2{6.0f, 0.0f}));
+    EXPECT(HasLineOfSight(Vec2{-6.0f, 3.0f}, Vec2{6.0f, 3.0f}));
+    EXPECT(!HasLineOfSight(Vec2{-6.0f, 3.0f}, Vec2{6.0f, 3.0f}, 1.5f));
+
+    RemoveStaticObstacle(OBSTACLE_TEST_ENTITY);
+    EXPECT(HasLineOfSight(Vec2{-6.0f, 0.0f}, Vec2{6.0f, 0.0f}));
+}
+
+// The tile between the unit and the enemy is blocked, the unit steps around it without cutting
+// its corners
+TEST(FlowFieldAvoidsBlockedTiles) {
+    BeginFlowFieldTest();
+    AddStaticObstacle(GetTestTileCenter(12, 16), 1.5f, OBSTACLE_TEST_ENTITY);
+    BuildObstacleField();
+    SetTestEnemies(10, 16, 1);
+    BuildFlowField(TEAM_RED, g_world_test_counts);
+
+    Vec2 around = SampleFlowField(TEAM_RED, GetTestTileCenter(13, 16));
+    Vec2 past = SampleFlowField(TEAM_RED, GetTestTileCenter(11, 16));
+    ClearStaticObstacles();
+
+    EXPECT(IsNear(around, Vec2{0.0f, 1.0f}) || IsNear(around, Vec2{0.0f, -1.0f}));
+    EXPECT(IsNear(past, Vec2{-1.0f, 0.0f}));
+}
+
+// A blocked tile holding enemies, such as a tower, is still led to
+TEST(FlowFieldLeadsToBlockedEnemyTile) {
+    BeginFlowFieldTest();
+    AddStaticObstacle(GetTestTileCenter(12, 16), 1.5f, OBSTACLE_TEST_ENTITY);
+    BuildObstacleField();
+    SetTestEnemies(12, 16, 1);
+    BuildFlowField(TEAM_RED, g_world_test_counts);
+
+    Vec2 toward = SampleFlowField(TEAM_RED, GetTestTileCenter(13, 16));
+    ClearStaticObstacles();
+
+    EXPECT(IsNear(toward, Vec2{-1.0f, 0.0f}));
+}